@@ -0,0 +1,167 @@
+#include "Bytecode.h"
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <algorithm>
+
+namespace {
+    inline std::string stripQuotes(const std::string& s) {
+        return (s.size() >= 2 && s.front() == '"' && s.back() == '"')
+             ? s.substr(1, s.size() - 2) : s;
+    }
+
+    uint16_t Stoi16(const std::string& s, const std::string& ctx = "<unknown>") {
+        try {
+            long v = std::stol(s);
+            if (v < 0) v = 0;
+            if (v > 65535) v = 65535;
+            return static_cast<uint16_t>(v);
+        } catch (const std::exception& e) {
+            std::cerr << " Debug: Stoi error in " << ctx
+                      << " : \"" << s << "\" – " << e.what() << '\n';
+            return 0;
+        }
+    }
+
+    constexpr int kMaxLoopDepth = 3;
+
+    struct Compiler {
+        Program out;
+        std::unordered_map<std::string, uint8_t> slots;
+        std::unordered_map<std::string, uint16_t> textIds;
+
+        uint8_t slot(const std::string& name) {
+            auto it = slots.find(name);
+            if (it != slots.end()) return it->second;
+            if (out.names.size() >= 256)
+                throw std::runtime_error("Program uses more than 256 registers");
+            uint8_t idx = static_cast<uint8_t>(out.names.size());
+            out.names.push_back(name);
+            slots.emplace(name, idx);
+            return idx;
+        }
+
+        // Messages are interned: large programs repeat a handful of them.
+        uint16_t text(const std::string& raw) {
+            auto it = textIds.find(raw);
+            if (it != textIds.end()) return it->second;
+            if (out.texts.size() > 65535)
+                throw std::runtime_error("Program uses more than 65536 messages");
+            uint16_t idx = static_cast<uint16_t>(out.texts.size());
+            out.texts.push_back(stripQuotes(raw));
+            textIds.emplace(raw, idx);
+            return idx;
+        }
+
+        // Emits prog at the given nesting depth; returns its executed-op count.
+        uint64_t emit(const std::vector<Instruction>& prog, int depth) {
+            uint64_t executed = 0;
+
+            for (const auto& ins : prog) {
+                ByteInstr bi;
+                bi.depth = static_cast<uint8_t>(depth);
+
+                switch (ins.op) {
+                    case OpCode::PRINT:
+                        bi.op = ByteOp::PRINT;
+                        bi.b  = text(ins.arg1);
+                        if (!ins.arg2.empty()) {
+                            bi.dst    = slot(ins.arg2);
+                            bi.flags |= ARG_C_REG;
+                        }
+                        break;
+
+                    case OpCode::DECLARE:
+                        bi.op  = ByteOp::DECLARE;
+                        bi.dst = slot(ins.arg1);
+                        bi.b   = Stoi16(ins.arg2, ins.arg1);
+                        break;
+
+                    case OpCode::ADD:
+                    case OpCode::SUBTRACT:
+                        bi.op  = (ins.op == OpCode::ADD) ? ByteOp::ADD : ByteOp::SUBTRACT;
+                        bi.dst = slot(ins.arg1);
+                        if (ins.isArg2Var) { bi.b = slot(ins.arg2); bi.flags |= ARG_B_REG; }
+                        else                 bi.b = Stoi16(ins.arg2, ins.arg2);
+                        if (ins.isArg3Var) { bi.c = slot(ins.arg3); bi.flags |= ARG_C_REG; }
+                        else                 bi.c = Stoi16(ins.arg3, ins.arg3);
+                        break;
+
+                    case OpCode::SLEEP:
+                        bi.op = ByteOp::SLEEP;
+                        bi.b  = Stoi16(ins.arg2);
+                        break;
+
+                    case OpCode::FOR:
+                        if (ins.body.empty() || ins.repetitions == 0
+                            || depth >= kMaxLoopDepth)
+                            break;      // stays a NOP, as before
+                        {
+                            bi.op  = ByteOp::LOOP_INIT;
+                            bi.b   = ins.repetitions;
+                            bi.c   = static_cast<uint16_t>(
+                                         std::min<std::size_t>(ins.body.size(), 65535));
+                            out.ops.push_back(bi);
+
+                            uint64_t bodyCount = emit(ins.body, depth + 1);
+
+                            ByteInstr next;
+                            next.op    = ByteOp::LOOP_NEXT;
+                            next.depth = bi.depth;
+                            out.ops.push_back(next);
+
+                            executed += 1 + bodyCount * ins.repetitions;
+                        }
+                        continue;
+
+                    default:
+                        break;
+                }
+
+                out.ops.push_back(bi);
+                ++executed;
+            }
+            return executed;
+        }
+    };
+
+    std::string operand(const Program& code, uint16_t v, bool isReg) {
+        return isReg ? code.names[v] : std::to_string(v);
+    }
+}
+
+Program compileProgram(const std::vector<Instruction>& prog)
+{
+    Compiler c;
+    uint64_t executed = c.emit(prog, 0);
+    c.out.numRegs   = static_cast<uint16_t>(c.out.names.size());
+    c.out.execCount = static_cast<uint32_t>(std::min<uint64_t>(executed, UINT32_MAX));
+    c.out.ops.shrink_to_fit();
+    return std::move(c.out);
+}
+
+std::string describeOp(const Program& code, const ByteInstr& in, uint16_t value)
+{
+    switch (in.op) {
+        case ByteOp::PRINT: {
+            std::string txt = code.texts[in.b];
+            if (in.flags & ARG_C_REG)
+                txt += '+' + code.names[in.dst] + ": " + std::to_string(value);
+            return "PRINT -> " + txt;
+        }
+        case ByteOp::DECLARE:
+            return "DECLARE " + code.names[in.dst] + '=' + std::to_string(in.b);
+        case ByteOp::ADD:
+        case ByteOp::SUBTRACT:
+            return (in.op == ByteOp::ADD ? "ADD(" : "SUB(")
+                 + code.names[in.dst] + ", "
+                 + operand(code, in.b, (in.flags & ARG_B_REG) != 0) + ", "
+                 + operand(code, in.c, (in.flags & ARG_C_REG) != 0) + ')';
+        case ByteOp::SLEEP:
+            return "SLEEP " + std::to_string(in.b);
+        case ByteOp::LOOP_INIT:
+            return "FOR×" + std::to_string(in.b) + " body=" + std::to_string(in.c);
+        default:
+            return std::string();
+    }
+}
@@ -0,0 +1,62 @@
+/* ---------- Bytecode.h ---------- */
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Instruction.h"
+
+/*
+ * Compiled form of an Instruction tree.
+ * Variables are interned into register slots and literals are parsed once.
+ * FOR becomes LOOP_INIT ... body ... LOOP_NEXT; the loop state lives in the
+ * process's frame stack, so a Program is immutable and can be shared.
+ */
+enum class ByteOp : uint8_t {
+    PRINT,      // texts[b], then value of register dst if ARG_C_REG
+    DECLARE,    // dst = b
+    ADD,        // dst = b + c (saturating)
+    SUBTRACT,   // dst = b - c (floored at 0)
+    SLEEP,      // sleep for b ticks
+    LOOP_INIT,  // push a frame of b repetitions; body of c instructions follows
+    LOOP_NEXT,  // rerun the top frame's body or pop it; costs no tick
+    NOP
+};
+
+enum : uint8_t {
+    ARG_B_REG = 1 << 0,     // b names a register instead of an immediate
+    ARG_C_REG = 1 << 1      // c names a register instead of an immediate
+};
+
+struct ByteInstr {
+    ByteOp   op{ByteOp::NOP};
+    uint8_t  flags{0};
+    uint8_t  depth{0};      // loop nesting, for log indentation
+    uint8_t  dst{0};
+    uint16_t b{0};
+    uint16_t c{0};
+};
+static_assert(sizeof(ByteInstr) == 8, "ByteInstr must stay fixed-size and compact");
+
+// One active FOR: where its body starts and how many passes are left.
+struct LoopFrame {
+    uint32_t bodyStart;
+    uint32_t remaining;
+};
+
+struct Program {
+    std::vector<ByteInstr>   ops;
+    std::vector<std::string> names;     // register slot -> variable name
+    std::vector<std::string> texts;     // PRINT messages, quotes stripped
+    uint16_t numRegs{0};
+    uint32_t execCount{0};              // instructions executed by a full run
+};
+
+Program compileProgram(const std::vector<Instruction>& prog);
+
+// Log text for one executed op; value is the PRINTed register's value.
+std::string describeOp(const Program& code, const ByteInstr& in, uint16_t value);
+
+#endif
@@ -4,7 +4,7 @@
 #include "Commands.h"
 #include "Screen.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     Commands commands;
     Screen screen;
 
@@ -14,13 +14,20 @@ int main() {
     screen.menuView();
 
     std::string configFile = "Config.txt";
+    bool turbo = false;
 
-    commands.initialize(configFile);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--turbo") turbo = true;
+        else                  configFile = arg;
+    }
+
+    commands.initialize(configFile, turbo);
 
     // Main loop to continuously take in commands, until exit.
     while (true) {
         std::cout << "> ";
-        std::getline(std::cin, command);
+        if (!std::getline(std::cin, command)) command = "exit";   // input closed
         commands.processCommand(command);
     }
 
@@ -0,0 +1,51 @@
+#include "CfsQueue.h"
+#include "ProcessRegistry.h"
+#include <algorithm>
+
+CfsQueue::CfsQueue(ProcessRegistry& registry, int sleeperCredit)
+    : registry(registry), sleeperCredit(static_cast<uint64_t>(std::max(0, sleeperCredit))) {}
+
+void CfsQueue::enqueue(ProcessHandle h)
+{
+    ProcessInfo& p = registry[h];
+    const uint64_t floor = minVruntime > sleeperCredit ? minVruntime - sleeperCredit : 0;
+    p.vruntime = std::max(p.vruntime, floor);
+    tree.emplace(p.vruntime, h);
+}
+
+void CfsQueue::push(int, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    enqueue(h);
+}
+
+void CfsQueue::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (const auto& q : dealt)
+        for (ProcessHandle h : q) enqueue(h);
+}
+
+bool CfsQueue::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    auto it = std::find_if(tree.begin(), tree.end(),
+                           [&](const std::pair<uint64_t, ProcessHandle>& e) {
+                               return registry[e.second].allowedOn(queueIdx + 1);
+                           });
+    if (it == tree.end()) return false;
+
+    // The floor follows the tree's least vruntime, not a pinned process
+    // picked from further back.
+    minVruntime = std::max(minVruntime, tree.begin()->first);
+    out = it->second;
+    tree.erase(it);
+    return true;
+}
+
+void CfsQueue::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (auto it = tree.begin(); it != tree.end() && out.size() < n; ++it)
+        out.push_back(it->second);
+}
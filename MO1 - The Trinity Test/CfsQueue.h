@@ -0,0 +1,43 @@
+/* ---------- CfsQueue.h ---------- */
+#ifndef CFSQUEUE_H
+#define CFSQUEUE_H
+
+#include <set>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+#include "ReadyQueue.h"
+
+class ProcessRegistry;
+
+/*
+ * Ready set of the fair scheduler: one tree (std::set, a red-black tree)
+ * ordered by virtual runtime and shared by all cores, so push and pop are
+ * O(log n). pop() takes the process that has had the least CPU.
+ *
+ * minVruntime follows the smallest vruntime handed out and never goes back.
+ * A queued process is placed no further back than minVruntime minus
+ * sleeperCredit: new processes and ones that slept start just ahead of the
+ * pack instead of monopolising the cores until they catch up.
+ */
+class CfsQueue final : public ReadyQueue {
+public:
+    CfsQueue(ProcessRegistry& registry, int sleeperCredit);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+
+private:
+    ProcessRegistry& registry;
+    const uint64_t   sleeperCredit;
+
+    std::mutex mx;
+    std::set<std::pair<uint64_t, ProcessHandle>> tree;     // (vruntime, handle)
+    uint64_t minVruntime{0};
+
+    void enqueue(ProcessHandle h);          // caller holds mx
+};
+
+#endif
@@ -0,0 +1,308 @@
+#include "ColumnArchive.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <memory>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+const char* const kPid      = "pid";
+const char* const kCore     = "core";
+const char* const kInstr    = "instructions";
+const char* const kArrival  = "arrival";
+const char* const kFinished = "finished";
+const char* const kMigrate  = "migrations";
+
+std::string columnPath(const std::string& prefix, const char* column)
+{
+    return prefix + column + ".col";
+}
+
+template <typename T>
+void put(std::vector<char>& buf, T v)
+{
+    const std::size_t at = buf.size();
+    buf.resize(at + sizeof(T));
+    std::memcpy(&buf[at], &v, sizeof(T));
+}
+
+// Value `index` of a buffered column.
+template <typename T>
+T at(const std::vector<char>& buf, std::size_t index)
+{
+    T v;
+    std::memcpy(&v, &buf[index * sizeof(T)], sizeof(T));
+    return v;
+}
+
+// Value `index` of a column file; false if the file is shorter.
+template <typename T>
+bool readAt(const std::string& path, uint64_t index, T& out)
+{
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(index * sizeof(T)));
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&out), sizeof(T)));
+}
+
+// Read-only view of a whole column file; empty if it is missing or empty.
+class MappedColumn {
+public:
+    explicit MappedColumn(const std::string& path)
+    {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+        data  = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        bytes = data ? static_cast<std::size_t>(size.QuadPart) : 0;
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat sb;
+        if (fstat(fd, &sb) != 0 || sb.st_size == 0) return;
+        void* p = mmap(nullptr, static_cast<std::size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) return;
+        madvise(p, static_cast<std::size_t>(sb.st_size), MADV_SEQUENTIAL);
+        data  = p;
+        bytes = static_cast<std::size_t>(sb.st_size);
+#endif
+    }
+
+    ~MappedColumn()
+    {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(data, bytes);
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    MappedColumn(const MappedColumn&) = delete;
+    MappedColumn& operator=(const MappedColumn&) = delete;
+
+    template <typename T>
+    const T* as() const { return static_cast<const T*>(data); }
+
+    template <typename T>
+    std::size_t rows() const { return bytes / sizeof(T); }
+
+private:
+    void*       data{nullptr};
+    std::size_t bytes{0};
+#ifdef _WIN32
+    HANDLE file{INVALID_HANDLE_VALUE};
+    HANDLE mapping{nullptr};
+#else
+    int fd{-1};
+#endif
+};
+
+uint64_t percentile(std::vector<uint64_t>& v, int p)
+{
+    auto nth = v.begin() + static_cast<std::ptrdiff_t>((v.size() - 1) * p / 100);
+    std::nth_element(v.begin(), nth, v.end());
+    return *nth;
+}
+
+} // namespace
+
+ColumnQuery ColumnQuery::parse(const std::string& args)
+{
+    ColumnQuery q;
+    std::istringstream iss(args);
+    std::string tok;
+    while (iss >> tok) {
+        const std::size_t eq = tok.find('=');
+        if (eq == std::string::npos)
+            throw std::runtime_error("Expected key=value, got \"" + tok + "\"");
+        const std::string key = tok.substr(0, eq);
+        const std::string val = tok.substr(eq + 1);
+
+        if (key == "metric") {
+            if      (val == "turnaround")   q.metric = TURNAROUND;
+            else if (val == "waiting")      q.metric = WAITING;
+            else if (val == "instructions") q.metric = INSTRUCTIONS;
+            else throw std::runtime_error("Unknown metric: " + val);
+        }
+        else if (key == "core") q.core      = std::stoi(val);
+        else if (key == "from") q.fromCycle = std::stoull(val);
+        else if (key == "to")   q.toCycle   = std::stoull(val);
+        else throw std::runtime_error("Unknown query key: " + key);
+    }
+    return q;
+}
+
+ColumnArchive::ColumnArchive(std::string prefix) : prefix(std::move(prefix))
+{
+    open();
+}
+
+ColumnArchive::~ColumnArchive()
+{
+    flush();
+}
+
+// Every run starts with empty columns, so a query never sees an earlier
+// run's rows, even before this run's first flush.
+void ColumnArchive::open()
+{
+    for (const char* c : { kPid, kCore, kInstr, kArrival, kFinished, kMigrate })
+        std::ofstream(columnPath(prefix, c), std::ios::binary | std::ios::trunc);
+}
+
+void ColumnArchive::append(const FinishedRow& row)
+{
+    put(pid, row.pid);
+    put(core, row.core);
+    put(instructions, row.instructions);
+    put(arrival, row.arrivalCycle);
+    put(finished, row.finishedCycle);
+    put(migrations, row.migrations);
+    if (++pending >= kBatchRows) flush();
+}
+
+// Rows still buffered come from memory, older ones from the files.
+bool ColumnArchive::readRow(uint64_t index, FinishedRow& out) const
+{
+    if (index >= written + pending) return false;
+
+    if (index >= written) {
+        const std::size_t i = static_cast<std::size_t>(index - written);
+        out.pid           = at<int32_t>(pid, i);
+        out.core          = at<int32_t>(core, i);
+        out.instructions  = at<uint32_t>(instructions, i);
+        out.arrivalCycle  = at<uint64_t>(arrival, i);
+        out.finishedCycle = at<uint64_t>(finished, i);
+        out.migrations    = at<uint32_t>(migrations, i);
+        return true;
+    }
+    return readAt(columnPath(prefix, kPid), index, out.pid)
+        && readAt(columnPath(prefix, kCore), index, out.core)
+        && readAt(columnPath(prefix, kInstr), index, out.instructions)
+        && readAt(columnPath(prefix, kArrival), index, out.arrivalCycle)
+        && readAt(columnPath(prefix, kFinished), index, out.finishedCycle)
+        && readAt(columnPath(prefix, kMigrate), index, out.migrations);
+}
+
+void ColumnArchive::flush()
+{
+    if (!pending) return;
+
+    const std::pair<const char*, std::vector<char>*> cols[] = {
+        { kPid, &pid }, { kCore, &core }, { kInstr, &instructions },
+        { kArrival, &arrival }, { kFinished, &finished }, { kMigrate, &migrations },
+    };
+    for (const auto& c : cols) {
+        std::ofstream out(columnPath(prefix, c.first), std::ios::binary | std::ios::app);
+        out.write(c.second->data(), static_cast<std::streamsize>(c.second->size()));
+        c.second->clear();
+    }
+    written += pending;
+    pending  = 0;
+}
+
+void ColumnArchive::query(const std::string& prefix, const ColumnQuery& q, std::ostream& os)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Map only what the filter and the metric read.
+    const bool window    = q.fromCycle != 0 || q.toCycle != UINT64_MAX;
+    const bool needCycle = window || q.metric != ColumnQuery::INSTRUCTIONS;
+    const bool needInstr = q.metric != ColumnQuery::TURNAROUND;
+
+    MappedColumn coreCol(columnPath(prefix, kCore));
+    std::unique_ptr<MappedColumn> finCol, arrCol, insCol;
+    std::size_t rows = coreCol.rows<int32_t>();
+    if (needCycle) {
+        finCol.reset(new MappedColumn(columnPath(prefix, kFinished)));
+        rows = std::min(rows, finCol->rows<uint64_t>());
+    }
+    if (needCycle && q.metric != ColumnQuery::INSTRUCTIONS) {
+        arrCol.reset(new MappedColumn(columnPath(prefix, kArrival)));
+        rows = std::min(rows, arrCol->rows<uint64_t>());
+    }
+    if (needInstr) {
+        insCol.reset(new MappedColumn(columnPath(prefix, kInstr)));
+        rows = std::min(rows, insCol->rows<uint32_t>());
+    }
+
+    if (rows == 0) {
+        os << "No finished processes archived yet.\n";
+        return;
+    }
+
+    const int32_t*  core = coreCol.as<int32_t>();
+    const uint64_t* fin  = finCol ? finCol->as<uint64_t>() : nullptr;
+    const uint64_t* arr  = arrCol ? arrCol->as<uint64_t>() : nullptr;
+    const uint32_t* ins  = insCol ? insCol->as<uint32_t>() : nullptr;
+
+    std::vector<uint64_t> values;
+    std::vector<uint64_t> perCore;      // index: core ID
+    uint64_t sum = 0;
+    values.reserve(rows);
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (window && (fin[i] < q.fromCycle || fin[i] > q.toCycle)) continue;
+        if (q.core >= 0 && core[i] != q.core) continue;
+
+        uint64_t v;
+        switch (q.metric) {
+            case ColumnQuery::TURNAROUND:   v = fin[i] - arr[i]; break;
+            case ColumnQuery::WAITING: {
+                const uint64_t turnaround = fin[i] - arr[i];
+                v = turnaround > ins[i] ? turnaround - ins[i] : 0;
+                break;
+            }
+            default:                        v = ins[i]; break;
+        }
+        values.push_back(v);
+        sum += v;
+        const std::size_t c = core[i] < 0 ? 0 : static_cast<std::size_t>(core[i]);
+        if (c >= perCore.size()) perCore.resize(c + 1);
+        ++perCore[c];
+    }
+
+    const double secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    static const char* const names[] = { "turnaround (cycles)", "waiting (cycles)", "instructions" };
+    os << "Rows scanned : " << rows << "\n"
+       << "Rows matched : " << values.size() << "\n";
+    if (!values.empty()) {
+        os << "Metric       : " << names[q.metric] << "\n"
+           << std::fixed << std::setprecision(1)
+           << "  avg " << static_cast<double>(sum) / values.size()
+           << "  min " << *std::min_element(values.begin(), values.end())
+           << "  p50 " << percentile(values, 50)
+           << "  p90 " << percentile(values, 90)
+           << "  p99 " << percentile(values, 99)
+           << "  max " << *std::max_element(values.begin(), values.end()) << "\n"
+           << "Per core     :";
+        for (std::size_t c = 0; c < perCore.size(); ++c)
+            if (perCore[c]) os << "  core " << c << ": " << perCore[c];
+        os << "\n";
+    }
+    os << std::setprecision(3) << "Scan time    : " << secs * 1000.0 << " ms ("
+       << std::setprecision(0) << (secs > 0 ? rows / secs : 0.0) << " rows/s)\n";
+}
@@ -0,0 +1,69 @@
+/* ---------- ColumnArchive.h ---------- */
+#ifndef COLUMNARCHIVE_H
+#define COLUMNARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+// One finished process as stored on disk; every field is its own column.
+struct FinishedRow {
+    int32_t  pid;
+    int32_t  core;
+    uint32_t instructions;
+    uint64_t arrivalCycle;
+    uint64_t finishedCycle;
+    uint32_t migrations;
+};
+
+// Filter and metric for report-util --query.
+struct ColumnQuery {
+    enum Metric { TURNAROUND, WAITING, INSTRUCTIONS };
+
+    Metric   metric{TURNAROUND};
+    int      core{-1};                  // -1: every core
+    uint64_t fromCycle{0};              // finished within [from, to]
+    uint64_t toCycle{UINT64_MAX};
+
+    // "metric=waiting core=2 from=1000 to=5000"; throws on a bad token.
+    static ColumnQuery parse(const std::string& args);
+};
+
+/*
+ * Append-only, column-per-file archive of finished processes.
+ * Each column is a flat array of fixed-width values in <prefix><column>.col;
+ * row i is element i of every file. Rows are buffered and written in
+ * batches; queries memory-map only the columns they read and scan them
+ * sequentially. Not thread-safe: FinishedArchive appends from its archive
+ * thread.
+ */
+class ColumnArchive {
+public:
+    explicit ColumnArchive(std::string prefix);
+    ~ColumnArchive();
+
+    ColumnArchive(const ColumnArchive&) = delete;
+    ColumnArchive& operator=(const ColumnArchive&) = delete;
+
+    void append(const FinishedRow& row);
+    void flush();
+    bool readRow(uint64_t index, FinishedRow& out) const;  // index: rows appended before it
+    const std::string& filePrefix() const { return prefix; }
+
+    // Scans the archive at prefix; prints counts, percentiles and per-core totals.
+    static void query(const std::string& prefix, const ColumnQuery& q, std::ostream& os);
+
+private:
+    static constexpr std::size_t kBatchRows = 4096;
+
+    std::string prefix;
+    std::size_t pending{0};
+    uint64_t    written{0};             // rows in the files
+    std::vector<char> pid, core, instructions, arrival, finished, migrations;
+
+    void open();
+};
+
+#endif
@@ -1,6 +1,9 @@
 #include "Commands.h"
 #include "ProcessInfo.h"
 #include "Instruction.h"
+#include "Bytecode.h"
+#include "ProgramGenerator.h"
+#include "Rng.h"
 #include "Scheduler.h"
 #include <iostream>
 #include <fstream>
@@ -8,238 +11,25 @@
 #include <stdexcept>
 #include <iomanip>
 #include <chrono>
-#include <random>
 #include <atomic>
 #include <algorithm>
 std::atomic<int> g_attachedPid{-1};
 
-static std::string randVar() {
-    static std::mt19937 rng{ std::random_device{}() };
-    return std::string(1, static_cast<char>('a' + (rng() % 26)));
-}
-
-static Instruction makeLeafInstr(std::vector<std::string>& vars)
-{
-    static std::mt19937 rng{ std::random_device{}() };
-    int code = rng() % 5;
-
-    /* ---------- PRINT ---------- */
-    if (code == 0) {
-        /* 50 % chance to emit a blank PRINT */
-        if (rng() & 1)
-            return Instruction(OpCode::PRINT, "\"\"", "", "", false, false);
-
-        if (vars.empty()) return makeLeafInstr(vars);
-        std::string v = vars[rng() % vars.size()];
-        return Instruction(OpCode::PRINT, "\"Value from: \"", v, "", false, true);
-    }
-
-    /* ---------- DECLARE ---------- */
-    if (code == 1) {
-        std::string v = randVar(); vars.push_back(v);
-        return Instruction(OpCode::DECLARE, v,
-                           std::to_string(Commands::getRandomInt(0, 65535)));
-    }
-
-    /* ---------- ADD / SUB ---------- */
-    if (code == 2 || code == 3) {
-        if (vars.empty()) return makeLeafInstr(vars);
-        std::string v1 = vars[rng() % vars.size()];
-        std::string a2 = std::to_string(Commands::getRandomInt(1, 500));
-        std::string a3 = std::to_string(Commands::getRandomInt(1, 500));
-        return Instruction(code == 2 ? OpCode::ADD : OpCode::SUBTRACT,
-                           v1, a2, a3);
-    }
-
-    /* ---------- SLEEP ---------- */
-    return Instruction(OpCode::SLEEP, "",
-                       std::to_string(Commands::getRandomInt(1, 5)));
-}
-
-static std::vector<Instruction>
-buildRandomProgram(int                       maxLogical,
-                   const Config&             cfg,
-                   std::vector<std::string>& vars,
-                   int                       depth      = 3,
-                   int                       fixedBody  = 3)
-{
-    static std::mt19937 rng{ std::random_device{}() };
-    std::vector<Instruction> prog;
-
-    auto used = [&]()->std::size_t { return logicalSize(prog); };
-
-    while (used() < static_cast<std::size_t>(maxLogical))
-    {
-        bool makeLoop = depth > 0 && (rng() % 4 == 0);
-        Instruction next;
-        std::size_t cost = 1;
-
-        if (makeLoop)
-        {
-            uint8_t reps = static_cast<uint8_t>(Commands::getRandomInt(2, 3));
-            auto body    = buildRandomProgram(fixedBody, cfg, vars,
-                                              depth - 1, fixedBody);
-            std::size_t bodyCost = logicalSize(body);
-            cost = 1 + bodyCost * reps;
-
-            if (used() + cost <= static_cast<std::size_t>(maxLogical))
-                next = Instruction(std::move(body), reps);
-            else
-                makeLoop = false;
-        }
-
-        if (!makeLoop)
-        {
-            next = makeLeafInstr(vars);
-            cost = 1;
-            if (used() + cost > static_cast<std::size_t>(maxLogical)) break;
-        }
-
-        prog.emplace_back(std::move(next));
-    }
-    return prog;
-}
-
-static Instruction randomInstr(const Config& cfg,
-                               std::vector<std::string>& vars)
-{
-    static std::mt19937 rng{ std::random_device{}() };
-    std::uniform_int_distribution<int> pickOp(0, 5);
-    int code = pickOp(rng);
-
-    switch (code)
-    {
-        /* ---------- PRINT ---------- */
-        case 0: {
-            if ((rng() & 3) == 0) {
-                return Instruction{OpCode::PRINT, "\"\"", "", "", false, false};
-            }
-            if (vars.empty()) {
-                std::string v = randVar();
-                vars.push_back(v);
-                return Instruction{
-                    OpCode::DECLARE,
-                    v,
-                    std::to_string(Commands::getRandomInt(0, 65535)),
-                    "",
-                    false,
-                    true
-                };
-            }
-            {
-                std::string v = vars[rng() % vars.size()];
-                return Instruction{
-                    OpCode::PRINT,
-                    "\"Value from: \"",
-                    v,
-                    "",
-                    false,
-                    true
-                };
-            }
-        }
-
-        /* ---------- DECLARE ---------- */
-        case 1: {
-            std::string v = randVar();
-            vars.push_back(v);
-            return Instruction{
-                OpCode::DECLARE,
-                v,
-                std::to_string(Commands::getRandomInt(0, 65535)),
-                "",
-                false,
-                true
-            };
-        }
-
-        /* ---------- ADD / SUBTRACT ---------- */
-        case 2:
-        case 3: {
-            if (vars.empty()) {
-                // fall back to something simpler
-                return randomInstr(cfg, vars);
-            }
-
-            bool rhs2Var = (rng() & 1);
-            bool rhs3Var = (rng() & 1);
-            std::string target = vars[rng() % vars.size()];
-            std::string arg2 = rhs2Var
-                ? vars[rng() % vars.size()]
-                : std::to_string(Commands::getRandomInt(0, 500));
-            std::string arg3 = rhs3Var
-                ? vars[rng() % vars.size()]
-                : std::to_string(Commands::getRandomInt(0, 500));
-
-            return Instruction{
-                code == 2 ? OpCode::ADD : OpCode::SUBTRACT,
-                target,
-                arg2,
-                arg3,
-                rhs2Var,
-                rhs3Var
-            };
-        }
-
-        /* ---------- SLEEP ---------- */
-        case 4: {
-            return Instruction{
-                OpCode::SLEEP,
-                "",
-                std::to_string(Commands::getRandomInt(1, 5)),
-                "",
-                false,
-                true
-            };
-        }
-
-        /* ---------- FOR (loop) ---------- */
-        default: {
-            // build a tiny one-instruction body
-            uint8_t reps = static_cast<uint8_t>(
-                Commands::getRandomInt(1, 3));
-            std::vector<Instruction> body;
-            body.push_back(makeLeafInstr(vars));
-            return Instruction(std::move(body), reps);
-        }
-    }
-}
-
-static int nextProcessID = 1; // For unique process IDs
+static std::atomic<int> nextProcessID{1}; // For unique process IDs; batch and console threads both take them
 
+// Draws from the calling thread's stream; see Rng.h.
 int Commands::getRandomInt(int floor, int ceiling) {
-    static std::mt19937 rng{ std::random_device{}() };
-    std::uniform_int_distribution<int> dist(floor, ceiling);
-    return dist(rng);
+    return Rng::between(floor, ceiling);
 }
 
 std::string Commands::getCurrentTimestamp() {
-    using namespace std::chrono;
-
-    // current time
-    auto tp    = system_clock::now();
-    auto ms    = duration_cast<milliseconds>(tp.time_since_epoch()) % 1000;
-    std::time_t tt = system_clock::to_time_t(tp);
-    std::tm    tm;
-
-#ifdef _WIN32
-    localtime_s(&tm, &tt);
-#else
-    localtime_r(&tt, &tm);
-#endif
-
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%m/%d/%Y %I:%M:%S")
-        << '.' << std::setfill('0') << std::setw(3) << ms.count()
-        << (tm.tm_hour < 12 ? "AM" : "PM");
-
-    return oss.str();
+    return formatTimestamp(nowMs());
 }
 
 // Constructor
 Commands::Commands() : scheduler(nullptr) {}
 
-void Commands::initialize(std::string filename) {
+void Commands::initialize(std::string filename, bool turbo) {
     if (scheduler == nullptr) {
         //bool fileLoaded = false;
 
@@ -257,20 +47,33 @@ void Commands::initialize(std::string filename) {
 
             try {
                 config = parseConfigFile(filename);
-                scheduler = std::make_unique<Scheduler>(config);
+                if (turbo) config.turbo = true;
+                Rng::setMasterSeed(config.seed);
+                Rng::bindThread(Rng::kMainStream);
+                scheduler = std::make_unique<Scheduler>(config, registry);
                 std::cout << "Scheduler initialized with "
-                          << config.numCpu << " CPUs." << std::endl;
+                          << config.numCpu << " CPUs"
+                          << (config.turbo ? " (turbo)" : "")
+                          << ", seed " << Rng::masterSeed() << "." << std::endl;
                 break;
             }
             catch (const std::exception& e) {
                 std::cerr << "Error parsing config file: "
                           << e.what() << std::endl;
-                std::exit(0);
+                shutdown();
             }
         }
     }
 }
 
+// Stops the cores and clock, then lets the log pipeline and finished
+// archive write out what they hold before the process ends.
+void Commands::shutdown() {
+    batchRunning = false;
+    scheduler.reset();
+    std::exit(0);
+}
+
 Config Commands::parseConfigFile(const std::string& filename) {
     Config cfg{};  // Initialize
 
@@ -298,6 +101,26 @@ Config Commands::parseConfigFile(const std::string& filename) {
                  key == "memPerFrame")           iss >> cfg.memPerFrame;
         else if (key == "mem-per-proc"      ||
                  key == "memPerProc")            iss >> cfg.memPerProc;
+        else if (key == "mem-alloc"         ||
+                 key == "memAlloc")              iss >> cfg.memAlloc;
+        else if (key == "mem-admission"     ||
+                 key == "memAdmission")          iss >> cfg.memAdmission;
+        else if (key == "finished-cap"      ||
+                 key == "finishedCap")           iss >> cfg.finishedCap;
+        else if (key == "seed")                    iss >> cfg.seed;
+        else if (key == "aging-cycles"      ||
+                 key == "agingCycles")           iss >> cfg.agingCycles;
+        else if (key == "cfs-latency"       ||
+                 key == "cfsLatency")            iss >> cfg.cfsLatency;
+        else if (key == "cfs-min-granularity" ||
+                 key == "cfsMinGranularity")     iss >> cfg.cfsMinGranularity;
+        else if (key == "mlfq-levels"       ||
+                 key == "mlfqLevels")            iss >> cfg.mlfqLevels;
+        else if (key == "mlfq-boost-cycles" ||
+                 key == "mlfqBoostCycles")       iss >> cfg.mlfqBoostCycles;
+        else if (key == "deadline-slack"    ||
+                 key == "deadlineSlack")         iss >> cfg.deadlineSlack;
+        else if (key == "turbo")                   iss >> cfg.turbo;
     }
 
     cfg.delaysPerExec++;
@@ -319,16 +142,22 @@ void Commands::processCommand(const std::string& command) {
     else if (command == "scheduler-stop") {
         schedulerStopCommand();
     }
+    else if (command.rfind("scheduler-burst", 0) == 0) {
+        schedulerBurstCommand(command.substr(std::string("scheduler-burst").size()));
+    }
     else if (command == "report-util") {
         reportUtilCommand();
     }
+    else if (command.rfind("report-util --query", 0) == 0) {
+        reportQueryCommand(command.substr(std::string("report-util --query").size()));
+    }
     else if (command == "clear") {
         clearScreen();
         menuView();
     }
     else if (command == "exit") {
         std::cout << "Terminating Serial OS, Thank you!" << std::endl;
-        exit(0);
+        shutdown();
     }
     else {
         std::cout << "ERROR: Unrecognized command." << std::endl;
@@ -340,12 +169,38 @@ void Commands::screenCommand(const std::string& cmdLine)
 {
     std::istringstream iss(cmdLine);
     std::string token, subCmd, procName;
+    int priority = kDefaultPriority;
+    long deadline = 0;
+    uint64_t affinity = 0;
 
     iss >> token; // first token is "screen"  (skip it)
     iss >> subCmd; // "-r", "-s", or "-ls"
     if (subCmd != "-ls") // only need a name for -r or -s
         iss >> procName;
 
+    // screen -s <name> [priority] [-d <ticks>] [-a <core,core,...>]
+    for (std::string opt; subCmd == "-s" && (iss >> opt); ) {
+        if (opt == "-a") {
+            std::string list;
+            if (!(iss >> list) || !(affinity = parseCoreList(list))) {
+                std::cout << "ERROR: Affinity must list cores 1 to " << config.numCpu
+                          << ", e.g. -a 1,3\n";
+                return;
+            }
+        }
+        else if (opt == "-d") {
+            if (!(iss >> deadline) || deadline <= 0 || deadline > UINT32_MAX) {
+                std::cout << "ERROR: Deadline must be a positive number of ticks\n";
+                return;
+            }
+        }
+        else if (!(std::istringstream(opt) >> priority)
+                 || priority < 0 || priority >= kPriorityLevels) {
+            std::cout << "ERROR: Priority must be 0 (most urgent) to " << kPriorityLevels - 1 << "\n";
+            return;
+        }
+    }
+
     if (subCmd.empty()) {
         std::cout << "ERROR: Missing subcommand. Use -r | -s | -ls\n";
         return;
@@ -354,9 +209,14 @@ void Commands::screenCommand(const std::string& cmdLine)
         std::cout << "ERROR: Process name required for " << subCmd << "\n";
         return;
     }
+    if (subCmd == "-s" && procName.size() > FinishedSummary::kMaxName) {
+        std::cout << "ERROR: Process name must be at most " << FinishedSummary::kMaxName
+                  << " characters\n";
+        return;
+    }
 
     if      (subCmd == "-r")  rSubCommand(procName);
-    else if (subCmd == "-s")  sSubCommand(procName);
+    else if (subCmd == "-s")  sSubCommand(procName, priority, static_cast<uint32_t>(deadline), affinity);
     else if (subCmd == "-ls") lsSubCommand();
     else   std::cout << "ERROR: Invalid subcommand. Use -r | -s | -ls\n";
 }
@@ -364,53 +224,74 @@ void Commands::screenCommand(const std::string& cmdLine)
 void Commands::rSubCommand(const std::string& name) {
     clearScreen();
     std::cout << "Attempting to reattach to process: " << name << std::endl;
+    enterProcessScreen(name);
+}
 
-    try {
-        ProcessInfo& process = scheduler->getProcess(name);
-        enterProcessScreen(process);
-    }
-    catch (const std::runtime_error& e) {
-        std::cerr << e.what() << std::endl;
+// "1,3" -> bits 0 and 2; 0 if any entry is not a core of this machine.
+uint64_t Commands::parseCoreList(const std::string& list) const
+{
+    uint64_t mask = 0;
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int core = 0;
+        std::istringstream num(item);
+        if (!(num >> core) || !num.eof() || core < 1 || core > config.numCpu || core > 64)
+            return 0;
+        mask |= 1ull << (core - 1);
     }
+    return mask;
 }
 
-void Commands::sSubCommand(const std::string& name)
+void Commands::sSubCommand(const std::string& name, int priority, uint32_t deadline, uint64_t affinity)
 {
-    try {
-        ProcessInfo& existing = scheduler->getProcess(name);
+    if (scheduler->knows(name)) {
         std::cout << "Reattaching to existing process: " << name << '\n';
-        enterProcessScreen(existing);
+        enterProcessScreen(name);
         return;
     }
-    catch (const std::runtime_error&) { }
 
     int lines = Commands::getRandomInt(config.minIns, config.maxIns);
 
-    ProcessInfo proc(nextProcessID++, name, lines, getCurrentTimestamp(), false);
-
-    std::vector<std::string> vars;
-    proc.prog = buildRandomProgram(lines, config, vars);
-    proc.totalLine = static_cast<int>(logicalSize(proc.prog));
-
-    scheduler->addProcess(std::move(proc));
+    claimUserName(name);
+    ProcessInfo proc(nextProcessID++, name, lines, nowMs(), false);
+    proc.seed        = programSeed(proc.processID);
+    proc.programSize = lines;
+    proc.priority    = priority;
+    proc.relDeadline = deadline;
+    proc.affinity    = affinity;
+
+    switch (scheduler->addProcess(std::move(proc))) {
+    case AddResult::ADDED:
+        break;
+    case AddResult::NAME_TAKEN:
+        std::cout << "ERROR: Process \"" << name << "\" already exists.\n";
+        return;
+    case AddResult::DEADLINE_REJECTED:
+        std::cout << "ERROR: Process \"" << name << "\" rejected: deadline cannot be met"
+                  << " within " << deadline << " ticks at the current load.\n";
+        return;
+    }
     std::cout << "Created process \"" << name << "\" (" << lines << " lines)\n";
 
-    enterProcessScreen(scheduler->getProcess(name));
+    enterProcessScreen(name);
 }
 
-void Commands::enterProcessScreen(ProcessInfo& proc)
+// Works from the name alone: the PCB may be reclaimed while we are attached.
+void Commands::enterProcessScreen(const std::string& name)
 {
-    const std::string name = proc.processName;
-
-    g_attachedPid = proc.processID; // attach
-
     {
-        ProcessInfo snap = scheduler->snapshotProcess(name);
+        ProcessStatus snap;
+        if (!scheduler->processStatus(name, snap)) {
+            std::cout << "Process not found: " << name << '\n';
+            return;
+        }
+        g_attachedPid = snap.pid; // attach
         clearScreen();
-        std::cout << "Process: "     << snap.processName << '\n'
-                  << "ID: "          << snap.processID   << '\n'
-                  << "Total Lines: " << snap.totalLine   << '\n';
-        displayProcessSmi(snap);
+        std::cout << "Process: "     << name       << '\n'
+                  << "ID: "          << snap.pid   << '\n'
+                  << "Total Lines: " << snap.total << '\n';
+        displayProcessSmi(name, snap);
     }
 
     while (true)
@@ -421,10 +302,11 @@ void Commands::enterProcessScreen(ProcessInfo& proc)
 
         if (cmd == "process-smi")
         {
-            ProcessInfo snap = scheduler->snapshotProcess(name);
-            displayProcessSmi(snap);
+            ProcessStatus snap;
+            if (!displayProcessSmi(name, snap))
+                break;
 
-            if (snap.isFinished)
+            if (snap.state == ProcState::FINISHED)
             {
                 std::cout << "\nProcess has finished.\n"
                           << "Press Enter to return to menu...";
@@ -455,7 +337,7 @@ void Commands::schedulerStartCommand()
     if (batchRunning) { std::cout << "scheduler-start already active.\n"; return; }
 
     batchRunning = true;
-    batchThread  = std::thread(&Commands::batchLoop, this);
+    scheduler->setCycleHook([this](uint64_t cycle) { batchLoop(cycle); });
     std::cout << "Continuous dummy-process generation...\n";
 }
 
@@ -464,33 +346,95 @@ void Commands::schedulerStopCommand()
     if (!batchRunning) { std::cout << "scheduler-start not active.\n"; return; }
 
     batchRunning = false;
-    if (batchThread.joinable()) batchThread.join();
+    scheduler->setCycleHook(nullptr);
     std::cout << "Stopped dummy-process generation...\n";
 }
 
+// Builds N dummy processes first, then hands them to the scheduler at once.
+void Commands::schedulerBurstCommand(const std::string& args)
+{
+    if (!scheduler) { std::cout << "Run 'initialize' first.\n"; return; }
+
+    std::istringstream iss(args);
+    long count = 0;
+    if (!(iss >> count) || count <= 0) {
+        std::cout << "Usage: scheduler-burst <N>\n";
+        return;
+    }
+
+    const int64_t created = nowMs();
+    std::vector<ProcessInfo> batch;
+    batch.reserve(static_cast<std::size_t>(count));
+    while (static_cast<long>(batch.size()) < count) {
+        const int   pid   = nextProcessID++;
+        std::string pname = "process" + std::to_string(pid);
+        if (userNameTaken(pname)) continue;
+
+        int lines = Commands::getRandomInt(config.minIns, config.maxIns);
+        batch.emplace_back(pid, pname, lines, created, false);
+        batch.back().seed        = programSeed(pid);
+        batch.back().programSize = lines;
+        batch.back().priority    = Commands::getRandomInt(0, kPriorityLevels - 1);
+        batch.back().relDeadline = generatedDeadline(lines);
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::size_t added = scheduler->addProcesses(std::move(batch));
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    std::ostringstream out;
+    out << "Injected " << added << " processes in "
+        << std::fixed << std::setprecision(2) << ms << " ms.\n";
+    std::cout << out.str();
+}
+
 // Process reporting and display
 void Commands::writeProcessReport(std::ostream& os) {
+    struct Row {
+        ProcessStatus st;
+        std::string   name;
+        int64_t       createdMs;
+    };
+
+    // Published statuses only: no scheduler lock. The read guard keeps live
+    // PCBs from being reclaimed while their name and creation time are copied;
+    // it is released before any output, so a slow console or disk never
+    // holds up a core reclaiming a finished process.
+    std::vector<Row> rows;
+    {
+        auto guard = registry->readGuard();
+        std::vector<ProcessStatus> all = scheduler->statusList();
+        rows.reserve(all.size());
+        for (const auto& st : all) {
+            if (st.state == ProcState::FINISHED) continue;
+            const ProcessInfo& process = (*registry)[st.handle];
+            rows.push_back(Row{ st, process.processName, process.createdMs });
+        }
+    }
+
     os << scheduler->utilisationString();
     os << "Waiting Queue:\n";
-    for (const auto& process : scheduler->getWaitingProcesses()) {
-        os << process.processName << "\t(" << process.timeStamp
-            << ")\tCore: N/A\t" << process.currentLine << " / " << process.totalLine << "\n";
+    for (const auto& r : rows) {
+        if (r.st.state == ProcState::RUNNING) continue;
+        os << r.name << "\t(" << formatTimestamp(r.createdMs)
+            << ")\tCore: N/A\t" << r.st.executed << " / " << r.st.total << "\n";
     }
 
     os << "\nRunning Queue:\n";
-    for (const auto& process : scheduler->getRunningProcesses()) {
-        os << process.processName << "\t(" << process.timeStamp
-            << ")\tCore: " << process.assignedCore << "\t" << process.currentLine << " / " << process.totalLine << "\n";
+    for (const auto& r : rows) {
+        if (r.st.state != ProcState::RUNNING) continue;
+        os << r.name << "\t(" << formatTimestamp(r.createdMs)
+            << ")\tCore: " << r.st.core << "\t" << r.st.executed << " / " << r.st.total << "\n";
     }
 
+    // Finished processes live only in the archive; the oldest may be on disk.
     os << "\nFinished processes:\n";
-    for (const auto& entry : scheduler->getFinishedProcesses()) {
-        const auto& process = entry.first;
-        int coreId = entry.second;
-        os << process.processName << "\t(" << process.timeStamp
-            << ")\tFinished\tCore: " << coreId
-            << "\t" << process.totalLine << " / " << process.totalLine << "\n";
-    }
+    const uint64_t spilled = scheduler->finishedSpilled();
+    if (spilled)
+        os << "(" << spilled << " earlier in " << scheduler->finishedSpillPath() << ")\n";
+    for (const auto& s : scheduler->finishedList())
+        FinishedArchive::formatLine(os, s);
 }
 
 void Commands::lsSubCommand() {
@@ -509,109 +453,112 @@ void Commands::reportUtilCommand() {
     }
 }
 
-void Commands::displayProcessSmi(ProcessInfo& process)
+// report-util --query [metric=turnaround|waiting|instructions] [core=N] [from=C] [to=C]
+void Commands::reportQueryCommand(const std::string& args)
 {
-    ProcessInfo cur = scheduler->snapshotProcess(process.processName);
-
-    int coreId = -1;
-    std::string status;
+    if (!scheduler) { std::cout << "Run 'initialize' first.\n"; return; }
 
-    const auto& finished = scheduler->getFinishedProcesses();
-    auto fit = std::find_if(finished.begin(), finished.end(),
-                            [&](const auto& e){
-                                return e.first.processID == cur.processID;
-                            });
-    if (fit != finished.end()) {
-        status = "Finished";
-        coreId = fit->second;
-        cur.executedLines = cur.totalLine;
+    try {
+        scheduler->queryFinished(ColumnQuery::parse(args), std::cout);
+    }
+    catch (const std::exception& e) {
+        std::cout << "ERROR: " << e.what() << "\n"
+                  << "Usage: report-util --query [metric=turnaround|waiting|instructions]"
+                     " [core=N] [from=CYCLE] [to=CYCLE]\n";
     }
+}
 
-    if (status.empty()) {
-        for (const auto& p : scheduler->getRunningProcesses()) {
-            if (p.processID == cur.processID) {
-                status = "Running";
-                coreId = p.assignedCore;
-                break;
-            }
-        }
+// Prints the process-smi block; false if the process is not known.
+bool Commands::displayProcessSmi(const std::string& name, ProcessStatus& cur)
+{
+    if (!scheduler->processStatus(name, cur)) {
+        std::cout << "Process not found: " << name << '\n';
+        return false;
     }
 
-    if (status.empty()) status = "Waiting";
+    int coreId = -1;
+    std::string status;
+    int shown = static_cast<int>(std::min(cur.executed, cur.total));
 
-    const int shown = std::min(cur.executedLines, cur.totalLine);
+    switch (cur.state) {
+        case ProcState::FINISHED:
+            status = "Finished";
+            coreId = cur.core;
+            shown  = static_cast<int>(cur.total);
+            break;
+        case ProcState::RUNNING:
+            status = "Running";
+            coreId = cur.core;
+            break;
+        default:
+            status = "Waiting";
+            break;
+    }
 
     constexpr const char* border =
         "====================  PROCESS SMI  ====================\n";
 
     std::stringstream out;
     out << '\n' << border << '\n'
-        << std::left << std::setw(15) << "Name"          << " : " << cur.processName  << '\n'
-        << std::setw(15)               << "PID"           << " : " << cur.processID    << '\n'
+        << std::left << std::setw(15) << "Name"          << " : " << name    << '\n'
+        << std::setw(15)               << "PID"           << " : " << cur.pid << '\n'
         << std::setw(15)               << "Assigned Core" << " : "
         << (coreId == -1 ? "N/A" : std::to_string(coreId))             << '\n'
+        << std::setw(15)               << "Migrations"    << " : " << cur.migrations << '\n'
         << std::setw(15)               << "Progress"      << " : "
-        << shown << " / " << cur.totalLine                               << '\n'
+        << shown << " / " << cur.total                                   << '\n'
         << std::setw(15)               << "Status"        << " : " << status << '\n'
         << border << '\n';
 
     std::cout << out.str();
+    return true;
 }
 
-void Commands::batchLoop()
+// Relative deadline for a generated process of `lines` instructions.
+uint32_t Commands::generatedDeadline(int lines) const
 {
-    const int tickMultiplier = config.delaysPerExec * 10;
+    if (config.deadlineSlack <= 0 || lines <= 0) return 0;
+    const uint64_t d = static_cast<uint64_t>(lines) * static_cast<uint64_t>(config.deadlineSlack);
+    return static_cast<uint32_t>(std::min<uint64_t>(d, UINT32_MAX));
+}
 
-    while (batchRunning.load()) {
-        std::this_thread::sleep_for(
-            std::chrono::milliseconds(config.batchProcessFreq * tickMultiplier)
-        );
+// Runs on the scheduler's clock thread once per CPU cycle.
+void Commands::claimUserName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lk(userNamesMutex);
+    userNames.insert(name);
+}
 
-        std::string pname = "process" + std::to_string(nextProcessID);
+bool Commands::userNameTaken(const std::string& name)
+{
+    std::lock_guard<std::mutex> lk(userNamesMutex);
+    return userNames.count(name) != 0;
+}
 
-        bool exists = false;
+void Commands::batchLoop(uint64_t cycle)
+{
+    if (cycle % std::max(1, config.batchProcessFreq) != 0) return;
 
-        for (auto const& p : scheduler->getWaitingProcesses()) {
-            if (p.processName == pname) {
-                exists = true;
-                break;
-            }
-        }
-        if (!exists) {
-            for (auto const& p : scheduler->getRunningProcesses()) {
-                if (p.processName == pname) {
-                    exists = true;
-                    break;
-                }
-            }
-        }
-        if (!exists) {
-            for (auto const& e : scheduler->getFinishedProcesses()) {
-                if (e.first.processName == pname) {
-                    exists = true;
-                    break;
-                }
-            }
-        }
+    const int   pid   = nextProcessID++;
+    std::string pname = "process" + std::to_string(pid);
 
-        if (exists) {
-            ++nextProcessID;
-            continue;
-        }
+    // A user may already have taken the name with "screen -s".
+    if (userNameTaken(pname))
+        return;
 
-        int lines = Commands::getRandomInt(config.minIns, config.maxIns);
-        ProcessInfo p(
-            nextProcessID++,
-            pname,
-            lines,
-            getCurrentTimestamp(),
-            false
-        );
-
-        std::vector<std::string> vars;
-        p.prog      = buildRandomProgram(lines, config, vars);
-        p.totalLine = static_cast<int>(logicalSize(p.prog));
-
-        scheduler->addProcess(std::move(p));
-    }
+    int lines = Commands::getRandomInt(config.minIns, config.maxIns);
+    ProcessInfo p(
+        pid,
+        pname,
+        lines,
+        nowMs(),
+        false
+    );
+
+    p.seed        = programSeed(p.processID);
+    p.programSize = lines;
+    p.priority    = Commands::getRandomInt(0, kPriorityLevels - 1);
+    p.relDeadline = generatedDeadline(lines);
+
+    scheduler->addProcess(std::move(p));
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <unordered_set>
 
 extern std::atomic<int> g_attachedPid;
 
@@ -19,34 +20,44 @@ class Commands : protected Screen, public Data {
 private:
     std::unique_ptr<Scheduler> scheduler;
     Config config;
-    std::vector<ProcessInfo> processList;
     void writeProcessReport(std::ostream& os);
     void startThread(ProcessInfo& proc);
     void editProcessScreen(ProcessInfo& proc);
-    void enterProcessScreen(ProcessInfo& proc);
-    void displayProcessSmi(ProcessInfo& process);
+    void enterProcessScreen(const std::string& name);
+    bool displayProcessSmi(const std::string& name, ProcessStatus& cur);
     Config parseConfigFile(const std::string& filename);
     std::mutex queueMutex;
+    // Names picked with "screen -s". Generated names are "process<pid>" with a
+    // fresh pid, so these are the only ones they can collide with; checking
+    // here keeps the batch hook off the finished archive's disk index.
+    std::unordered_set<std::string> userNames;
+    std::mutex userNamesMutex;
+    void claimUserName(const std::string& name);
+    bool userNameTaken(const std::string& name);
     std::atomic<bool> batchRunning{false};
-    std::thread       batchThread;
-    void batchLoop();
+    void batchLoop(uint64_t cycle);
+    uint32_t generatedDeadline(int lines) const;
 
 public:
     Commands();
     static int getRandomInt(int floor, int ceiling);
     static std::string getCurrentTimestamp();
-    void initialize(std::string configFile);
+    void initialize(std::string configFile, bool turbo = false);
     void initialScreen();
     void processCommand(const std::string& command);
     void screenCommand(const std::string& command);
     void rSubCommand(const std::string& name);
-    void sSubCommand(const std::string& name);
+    void sSubCommand(const std::string& name, int priority = kDefaultPriority,
+                     uint32_t deadline = 0, uint64_t affinity = 0);
+    uint64_t parseCoreList(const std::string& list) const;
     void lsSubCommand();
     void schedulerStartCommand();
     void schedulerStopCommand();
+    void schedulerBurstCommand(const std::string& args);
     void reportUtilCommand();
+    void reportQueryCommand(const std::string& args);
     void displayProcess(const ProcessInfo& process);
-    void createProcess(const std::string& name);
+    [[noreturn]] void shutdown();
 };
 
 #endif
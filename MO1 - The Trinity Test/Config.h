@@ -2,6 +2,7 @@
 #define CONFIG_H
 
 #include <string>
+#include <cstdint>
 
 struct Config {
     int numCpu;
@@ -14,6 +15,17 @@ struct Config {
     int maxOverallMem;
     int memPerFrame;
     int memPerProc;
+    std::string memAlloc;   // placement policy: first-fit, best-fit, worst-fit, next-fit
+    std::string memAdmission;   // memory-wait order: fifo or smallest-fit
+    int finishedCap;    // finished summaries kept in memory before spilling to disk
+    uint64_t seed;      // master RNG seed; 0 picks a random one
+    int agingCycles;    // priority scheduler: cycles waited before moving up a level
+    int cfsLatency;     // fair scheduler: ticks in which every runnable process runs once
+    int cfsMinGranularity;  // fair scheduler: shortest slice, however many are runnable
+    int mlfqLevels;     // mlfq scheduler: number of queues; level l gets quantum << l
+    int mlfqBoostCycles;    // mlfq scheduler: cycles between resets to the top queue
+    int deadlineSlack;  // generated processes get a deadline of instructions x slack ticks; 0: none
+    bool turbo;     // virtual ticks only, no wall-clock sleeps
 };
 
 #endif
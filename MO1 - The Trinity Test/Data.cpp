@@ -5,41 +5,50 @@
 #include <ctime>
 #include <iomanip>
 #include <sstream>
-#include "Commands.h"
-
-static int nextProcessID = 1; // For unique process IDs
-
-void Data::createProcess(const std::string& processName) {
-    std::string timestamp = Commands::getCurrentTimestamp();
-    ProcessInfo newProcess(nextProcessID++, processName, 100, timestamp);
-    processList.push_back(newProcess);
-}
-
-ProcessInfo& Data::getProcess(const std::string& processName) {
-    for (auto& process : processList) {
-        if (process.processName == processName) {
-            return process;
-        }
-    }
-    throw std::runtime_error("ERROR: Process '" + processName + "' not found.");
-}
+#include <chrono>
+#include <cstdio>
 
 void Data::listAllProcess() {
-    for (const auto& process : processList) {
+    auto guard = registry->readGuard();
+    registry->forEach([this](ProcessHandle h) {
+        const ProcessInfo&  process = (*registry)[h];
+        const ProcessStatus st      = registry->status(h).read();
+        const bool finished = st.state == ProcState::FINISHED;
         std::cout << "Process Name: " << process.processName
-            << ", Status: " << (process.isFinished ? "Finished" : "Running")
-            << ", Timestamp: " << process.timeStamp;
+            << ", Status: " << (finished ? "Finished" : "Running")
+            << ", Timestamp: " << formatTimestamp(process.createdMs);
 
-        if (!process.isFinished) {
-            std::cout << ", Current Line: " << process.currentLine;
+        if (!finished) {
+            std::cout << ", Current Line: " << st.executed;
         }
         std::cout << std::endl;
-    }
+    });
+}
+
+int64_t Data::nowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void Data::formatTimestamp(int64_t ms, char* out, std::size_t n) {
+    const std::time_t tt = static_cast<std::time_t>(ms / 1000);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm);
+#endif
+    const int hour12 = tm.tm_hour % 12 ? tm.tm_hour % 12 : 12;
+    std::snprintf(out, n, "%02d/%02d/%04d %02d:%02d:%02d.%03d%s",
+                  tm.tm_mon + 1, tm.tm_mday, tm.tm_year + 1900,
+                  hour12, tm.tm_min, tm.tm_sec, static_cast<int>(ms % 1000),
+                  tm.tm_hour < 12 ? "AM" : "PM");
 }
 
-void Data::updateProcessLine(const std::string& processName, int line) {
-    auto& process = getProcess(processName);
-    process.currentLine = line;
+std::string Data::formatTimestamp(int64_t ms) {
+    char buf[32];
+    formatTimestamp(ms, buf, sizeof(buf));
+    return buf;
 }
 
 std::string Data::getTimestamp() const {
@@ -2,22 +2,25 @@
 #define DATA_H
 
 #include <string>
-#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include "ProcessInfo.h"
+#include "ProcessRegistry.h"
 
 class Data {
 
 public:
-    Data() {}
-    std::vector<ProcessInfo> processList;
-    ProcessInfo& getProcess(const std::string& processName);
-    void createProcess(const std::string& processName);
-    const std::vector<ProcessInfo>& getProcessList() const {
-        return processList;
-    }
-    void updateProcessLine(const std::string& processName, int line);
+    Data() : registry(std::make_shared<ProcessRegistry>()) {}
+    std::shared_ptr<ProcessRegistry> registry;     // shared with the Scheduler
     void listAllProcess();
     std::string getTimestamp() const;
+
+    // Wall-clock milliseconds since the epoch. Processes keep this and format
+    // it only when shown, as "MM/DD/YYYY hh:mm:ss.mmmAM" (25 characters).
+    static int64_t nowMs();
+    static void formatTimestamp(int64_t ms, char* out, std::size_t n);
+    static std::string formatTimestamp(int64_t ms);
 };
 
 #endif
@@ -0,0 +1,37 @@
+#include "EdfQueue.h"
+#include "ProcessRegistry.h"
+
+EdfQueue::EdfQueue(ProcessRegistry& registry)
+    : registry(registry) {}
+
+void EdfQueue::enqueue(ProcessHandle h)
+{
+    const ProcessInfo& p = registry[h];
+    heap.push(Entry{ p.deadline ? p.deadline : UINT64_MAX, nextSeq++, h });
+}
+
+void EdfQueue::push(int, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    enqueue(h);
+}
+
+void EdfQueue::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (const auto& q : dealt)
+        for (ProcessHandle h : q) enqueue(h);
+}
+
+bool EdfQueue::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    return popHeapIf(heap, passed,
+                     [&](ProcessHandle h) { return registry[h].allowedOn(queueIdx + 1); }, out);
+}
+
+void EdfQueue::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    peekHeap(heap, n, out);
+}
@@ -0,0 +1,50 @@
+/* ---------- EdfQueue.h ---------- */
+#ifndef EDFQUEUE_H
+#define EDFQUEUE_H
+
+#include <queue>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include "ReadyQueue.h"
+
+class ProcessRegistry;
+
+/*
+ * Ready set of the edf scheduler: a min-heap keyed on absolute deadline
+ * (ProcessInfo::deadline), shared by all cores. Processes without a
+ * deadline sort after every one that has one, in arrival order, so they
+ * only get the cores the real-time work leaves idle.
+ */
+class EdfQueue final : public ReadyQueue {
+public:
+    explicit EdfQueue(ProcessRegistry& registry);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+
+private:
+    struct Entry {
+        uint64_t      deadline;     // UINT64_MAX: none
+        uint64_t      seq;          // arrival order, breaks ties
+        ProcessHandle h;
+
+        bool operator>(const Entry& o) const {
+            return deadline != o.deadline ? deadline > o.deadline : seq > o.seq;
+        }
+    };
+
+    ProcessRegistry& registry;
+
+    std::mutex mx;
+    MinHeap<Entry> heap;
+    std::vector<Entry> passed;  // pop() scratch
+    uint64_t nextSeq{0};
+
+    void enqueue(ProcessHandle h);          // caller holds mx
+};
+
+#endif
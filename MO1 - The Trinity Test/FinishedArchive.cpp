@@ -0,0 +1,219 @@
+#include "FinishedArchive.h"
+#include <ostream>
+#include <cstdio>
+#include <chrono>
+
+namespace {
+    constexpr std::size_t kWakeRows = 4096;    // queued rows that wake the archive thread early
+    constexpr auto kWritePeriod = std::chrono::milliseconds(200);
+}
+
+FinishedArchive::FinishedArchive(std::size_t cap, std::string spillPath)
+    : cap(cap ? cap : 1), path(std::move(spillPath)), names("finished-names.idx"),
+      columns("finished-")
+{
+    writer = std::thread(&FinishedArchive::writerLoop, this);
+}
+
+FinishedArchive::~FinishedArchive()
+{
+    close();
+}
+
+void FinishedArchive::formatLine(std::ostream& os, const FinishedSummary& s)
+{
+    os << s.name << "\t(" << s.timeStamp
+       << ")\tFinished\tCore: " << s.core
+       << "\t" << s.total << " / " << s.total << "\n";
+}
+
+void FinishedArchive::add(const FinishedSummary& s)
+{
+    std::lock_guard<std::mutex> lk(mx);
+
+    toColumns.push_back(FinishedRow{ s.pid, s.core, s.total, s.arrivalCycle, s.finishedCycle,
+                                     s.migrations });
+    turnaroundSum += s.finishedCycle - s.arrivalCycle;
+
+    if (ring.size() < cap) {
+        ring.push_back(s);
+    }
+    else {
+        FinishedSummary& oldest = ring[head % cap];
+        toSpill.push_back(oldest);
+        auto it = byName.find(oldest.name);
+        if (it != byName.end() && it->second == head)
+            byName.erase(it);
+        ++head;
+        oldest = s;
+    }
+    byName[s.name] = count++;
+
+    if (toColumns.size() == kWakeRows) wake.notify_one();
+}
+
+void FinishedArchive::writerLoop()
+{
+    std::unique_lock<std::mutex> lk(mx);
+    for (;;) {
+        wake.wait_for(lk, kWritePeriod, [&] {
+            return !running || syncWanted || toColumns.size() >= kWakeRows;
+        });
+        const bool stopping = !running;
+        syncWanted = false;
+
+        // Take the queues; what is being written stays readable from
+        // spilling and inFlight.
+        spilling.swap(toSpill);
+        inFlight.swap(toColumns);
+        inFlightFrom = queuedFrom;
+        queuedFrom   = count;
+        const uint64_t through = count;
+        lk.unlock();
+
+        {
+            std::lock_guard<std::mutex> ioLk(io);
+            if (!spilling.empty() && !spill.is_open())
+                spill.open(path, std::ios::trunc);
+            for (const FinishedSummary& e : spilling) {
+                names.add(e.name, SpillEntry{ spillSeq++, static_cast<uint64_t>(spill.tellp()) });
+                formatLine(spill, e);
+            }
+            if (spill.is_open()) spill.flush();
+            for (const FinishedRow& r : inFlight) columns.append(r);
+            columns.flush();
+        }
+
+        lk.lock();
+        spilling.clear();
+        inFlight.clear();
+        inFlightFrom = queuedFrom;
+        flushedThrough = through;
+        synced.notify_all();
+        if (stopping && toColumns.empty() && toSpill.empty()) break;
+    }
+}
+
+void FinishedArchive::sync()
+{
+    std::unique_lock<std::mutex> lk(mx);
+    const uint64_t target = count;
+    if (flushedThrough >= target) return;
+    syncWanted = true;
+    wake.notify_one();
+    synced.wait(lk, [&] { return flushedThrough >= target || !running; });
+}
+
+void FinishedArchive::close()
+{
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        running = false;
+    }
+    wake.notify_one();
+    if (writer.joinable()) writer.join();
+}
+
+bool FinishedArchive::find(const std::string& name, FinishedSummary& out) const
+{
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        auto it = byName.find(name);
+        if (it != byName.end()) {
+            out = ring[it->second % cap];
+            return true;
+        }
+
+        // Pushed out of the ring, but its spill line is not written yet.
+        for (const std::vector<FinishedSummary>* q : { &toSpill, &spilling })
+            for (auto e = q->rbegin(); e != q->rend(); ++e)
+                if (name == e->name) {
+                    out = *e;
+                    return true;
+                }
+    }
+
+    // Anything else by that name is in the spill file already.
+    std::lock_guard<std::mutex> ioLk(io);
+    return findSpilled(name, out);
+}
+
+// The index narrows the spill file down to lines whose name hashes alike;
+// the line confirms the name and has the timestamp, and the column row with
+// the same sequence number has the figures.
+bool FinishedArchive::findSpilled(const std::string& name, FinishedSummary& out) const
+{
+    std::vector<SpillEntry> hits;
+    names.candidates(name, hits);
+    if (hits.empty()) return false;
+
+    if (!spillIn.is_open()) spillIn.open(path);
+    const std::string key = name + '\t';
+    std::string line;
+    for (auto hit = hits.rbegin(); hit != hits.rend(); ++hit) {
+        spillIn.clear();
+        spillIn.seekg(static_cast<std::streamoff>(hit->offset));
+        if (!std::getline(spillIn, line) || line.compare(0, key.size(), key) != 0)
+            continue;
+
+        FinishedRow row;
+        if (!columns.readRow(hit->seq, row)) return false;
+        out = FinishedSummary{};
+        out.pid           = row.pid;
+        out.core          = static_cast<int16_t>(row.core);
+        out.total         = row.instructions;
+        out.migrations    = row.migrations;
+        out.arrivalCycle  = row.arrivalCycle;
+        out.finishedCycle = row.finishedCycle;
+        std::snprintf(out.name, sizeof(out.name), "%s", name.c_str());
+
+        // "<name>\t(<timestamp>)\tFinished..."
+        const std::size_t open  = key.size() + 1;
+        const std::size_t close = line.find(')', open);
+        if (close != std::string::npos)
+            std::snprintf(out.timeStamp, sizeof(out.timeStamp), "%s",
+                          line.substr(open, close - open).c_str());
+        return true;
+    }
+    return false;
+}
+
+bool FinishedArchive::contains(const std::string& name) const
+{
+    FinishedSummary s;
+    return find(name, s);
+}
+
+std::vector<FinishedSummary> FinishedArchive::recent() const
+{
+    std::lock_guard<std::mutex> lk(mx);
+    std::vector<FinishedSummary> out;
+    out.reserve(ring.size());
+    for (uint64_t seq = head; seq < count; ++seq)
+        out.push_back(ring[seq % cap]);
+    return out;
+}
+
+void FinishedArchive::query(const ColumnQuery& q, std::ostream& os)
+{
+    sync();
+    ColumnArchive::query(columns.filePrefix(), q, os);
+}
+
+double FinishedArchive::meanTurnaround(uint64_t& finished) const
+{
+    std::lock_guard<std::mutex> lk(mx);
+    finished = count;
+    return count ? static_cast<double>(turnaroundSum) / count : 0.0;
+}
+
+uint64_t FinishedArchive::spilled()
+{
+    uint64_t evicted;
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        evicted = head;
+    }
+    sync();     // every one of them is in the file now
+    return evicted;
+}
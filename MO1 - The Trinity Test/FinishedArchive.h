@@ -0,0 +1,110 @@
+/* ---------- FinishedArchive.h ---------- */
+#ifndef FINISHEDARCHIVE_H
+#define FINISHEDARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <fstream>
+#include <unordered_map>
+#include <cstdint>
+#include "ColumnArchive.h"
+#include "SpillIndex.h"
+
+// What is left of a process once it finishes; its PCB, program and
+// registers are freed.
+struct FinishedSummary {
+    int32_t  pid{-1};
+    int16_t  core{-1};
+    uint32_t total{0};
+    uint32_t migrations{0};
+    uint64_t arrivalCycle{0};
+    uint64_t finishedCycle{0};
+    char     name[64]{};
+    char     timeStamp[32]{};
+
+    // Longest name kept whole; "screen -s" refuses longer ones.
+    static constexpr std::size_t kMaxName = sizeof(name) - 1;
+};
+
+/*
+ * Bounded record of finished processes, oldest first.
+ * Holds at most `cap` summaries in a ring; each one pushed out is appended
+ * to the spill file as a report line, so memory stays flat however long the
+ * emulator runs. Every summary is also appended to a ColumnArchive for
+ * report-util --query. The in-memory name index covers the ring only; a
+ * spilled process is found through an on-disk SpillIndex over the spill
+ * file, its figures read back from its column row. Thread-safe; the clock
+ * adds, monitors read.
+ *
+ * add() only touches memory. Spill lines and column rows are queued and
+ * written by the archive's own thread, so retiring a finished process never
+ * waits on the disk. That thread flushes both files on every pass, at most
+ * 200 ms apart, and once more on close().
+ */
+class FinishedArchive {
+public:
+    FinishedArchive(std::size_t cap, std::string spillPath);
+    ~FinishedArchive();
+
+    FinishedArchive(const FinishedArchive&) = delete;
+    FinishedArchive& operator=(const FinishedArchive&) = delete;
+
+    void add(const FinishedSummary& s);
+    bool find(const std::string& name, FinishedSummary& out) const;
+    bool contains(const std::string& name) const;
+    std::vector<FinishedSummary> recent() const;        // in finishing order
+    uint64_t spilled();                                 // flushes the spill file first
+    double   meanTurnaround(uint64_t& finished) const;  // cycles, over every summary added
+    const std::string& spillPath() const { return path; }
+
+    // Writes out queued column rows, then runs q over the whole history.
+    void query(const ColumnQuery& q, std::ostream& os);
+
+    // Blocks until every summary added so far is in the files.
+    void sync();
+    // Writes out what is queued and stops the archive thread.
+    void close();
+
+    static void formatLine(std::ostream& os, const FinishedSummary& s);
+
+private:
+    const std::size_t cap;
+    const std::string path;
+
+    mutable std::mutex mx;
+    std::condition_variable wake;       // archive thread: rows queued, sync or close
+    std::condition_variable synced;     // sync(): a pass finished
+    std::vector<FinishedSummary> ring;
+    uint64_t head{0};           // sequence number of ring's oldest entry
+    uint64_t count{0};          // summaries added so far
+    uint64_t turnaroundSum{0};  // cycles, over all `count`
+    std::unordered_map<std::string, uint64_t> byName;  // name -> sequence, ring entries only
+
+    // Waiting for the archive thread: rows [queuedFrom, count) in toColumns,
+    // rows [inFlightFrom, queuedFrom) in inFlight while a pass writes them.
+    // Evicted summaries likewise sit in toSpill, then spilling.
+    std::vector<FinishedSummary> toSpill, spilling;
+    std::vector<FinishedRow>     toColumns, inFlight;
+    uint64_t queuedFrom{0};
+    uint64_t inFlightFrom{0};
+    uint64_t flushedThrough{0}; // rows known to be in the files
+    bool     syncWanted{false};
+    bool     running{true};
+
+    // Archive thread side; readers of written rows take io.
+    mutable std::mutex io;
+    std::ofstream spill;        // opened on the first eviction
+    mutable std::ifstream spillIn;      // reads spill lines back for lookups
+    uint64_t spillSeq{0};       // sequence number of the next line spilled
+    SpillIndex names;
+    ColumnArchive columns;
+    std::thread writer;
+
+    void writerLoop();
+    bool findSpilled(const std::string& name, FinishedSummary& out) const;    // caller holds io
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "LogPipeline.h"
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+
+namespace {
+    constexpr std::size_t kRingRecords  = 4096;
+    constexpr std::size_t kMaxOpenFiles = 256;
+
+    uint64_t wallClockMs() {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(
+            duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    }
+}
+
+LogRing::LogRing(std::size_t capacityPow2)
+    : buf(capacityPow2), mask(capacityPow2 - 1) {}
+
+bool LogRing::push(const LogRecord& rec)
+{
+    const uint64_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) > mask) return false;   // full
+    buf[t & mask] = rec;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+LogPipeline::LogPipeline(int producers)
+{
+    for (int i = 0; i < producers; ++i)
+        rings.emplace_back(new LogRing(kRingRecords));
+    writer = std::thread(&LogPipeline::writerLoop, this);
+}
+
+LogPipeline::~LogPipeline()
+{
+    stop();
+}
+
+void LogPipeline::stop()
+{
+    running = false;
+    if (writer.joinable()) writer.join();
+}
+
+void LogPipeline::open(int pid, const std::string& name,
+                       std::shared_ptr<const Program> code)
+{
+    std::lock_guard<std::mutex> lk(regMutex);
+    registrations.push_back(Registration{ pid, name, std::move(code) });
+}
+
+void LogPipeline::push(int producer, const LogRecord& rec)
+{
+    // A full ring means the writer is behind; wait for it rather than drop output.
+    LogRing& ring = *rings[producer];
+    while (!ring.push(rec))
+        std::this_thread::yield();
+}
+
+void LogPipeline::record(int producer, int pid, uint32_t& seq, uint32_t line,
+                         uint16_t core, const ByteInstr& op, uint16_t value)
+{
+    LogRecord rec{};
+    rec.wallMs = wallClockMs();
+    rec.pid    = pid;
+    rec.seq    = seq++;
+    rec.line   = line;
+    rec.core   = core;
+    rec.kind   = LOG_OP;
+    rec.op     = op;
+    rec.value  = value;
+    push(producer, rec);
+}
+
+void LogPipeline::close(int producer, int pid, uint32_t& seq)
+{
+    LogRecord rec{};
+    rec.pid  = pid;
+    rec.seq  = seq++;
+    rec.kind = LOG_CLOSE;
+    push(producer, rec);
+}
+
+void LogPipeline::writerLoop()
+{
+    for (;;) {
+        const bool stopping = !running.load();
+
+        adoptRegistrations();
+        std::size_t drained = 0;
+        for (auto& ring : rings)
+            drained += ring->drain([&](const LogRecord& rec) { consume(rec); });
+        flushStreams();
+
+        if (stopping && drained == 0) break;
+        if (drained == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (auto& kv : streams)
+        if (kv.second.file.is_open()) kv.second.file.close();
+    streams.clear();
+}
+
+void LogPipeline::adoptRegistrations()
+{
+    std::vector<Registration> batch;
+    {
+        std::lock_guard<std::mutex> lk(regMutex);
+        batch.swap(registrations);
+    }
+    for (auto& r : batch) {
+        Stream& s = streams[r.pid];
+        s.name = std::move(r.name);
+        s.code = std::move(r.code);
+    }
+}
+
+void LogPipeline::consume(const LogRecord& rec)
+{
+    auto it = streams.find(rec.pid);
+    if (it == streams.end()) {
+        adoptRegistrations();
+        it = streams.find(rec.pid);
+        if (it == streams.end()) return;        // never registered
+    }
+    Stream& s = it->second;
+
+    if (!s.dirty) {
+        s.dirty = true;
+        dirty.push_back(rec.pid);
+    }
+
+    if (rec.seq != s.nextSeq) {
+        s.early.emplace(rec.seq, rec);
+        return;
+    }
+
+    format(s, rec);
+    ++s.nextSeq;
+    for (auto e = s.early.begin(); e != s.early.end() && e->first == s.nextSeq;
+         e = s.early.erase(e)) {
+        format(s, e->second);
+        ++s.nextSeq;
+    }
+}
+
+void LogPipeline::format(Stream& s, const LogRecord& rec)
+{
+    if (rec.kind == LOG_CLOSE) {
+        s.closing = true;
+        return;
+    }
+    if (!s.code) return;
+
+    s.pending += stamp(rec.wallMs);
+    s.pending += " | Core:";
+    s.pending += std::to_string(rec.core);
+    s.pending += " [";
+    s.pending += std::to_string(rec.line);
+    s.pending += "] ";
+    s.pending.append(rec.op.depth * 4, ' ');
+    s.pending += describeOp(*s.code, rec.op, rec.value);
+    s.pending += '\n';
+}
+
+void LogPipeline::flushStreams()
+{
+    for (int pid : dirty) {
+        auto it = streams.find(pid);
+        if (it == streams.end()) continue;
+        Stream& s = it->second;
+        s.dirty = false;
+
+        if (!s.pending.empty()) {
+            if (!s.file.is_open()) {
+                // Too many handles: park the oldest idle file, it reopens on demand.
+                while (openFiles >= kMaxOpenFiles && !openOrder.empty()) {
+                    int victim = openOrder.front();
+                    openOrder.pop_front();
+                    auto v = streams.find(victim);
+                    if (v != streams.end() && v->second.file.is_open()) {
+                        v->second.file.close();
+                        --openFiles;
+                    }
+                }
+                s.file.open(s.name + ".txt", std::ios::app);
+                if (s.file.is_open()) {
+                    ++openFiles;
+                    openOrder.push_back(pid);
+                }
+            }
+            s.file.write(s.pending.data(), static_cast<std::streamsize>(s.pending.size()));
+            s.pending.clear();
+        }
+
+        if (s.closing && s.early.empty()) {
+            if (s.file.is_open()) { s.file.close(); --openFiles; }
+            streams.erase(it);
+        }
+    }
+    dirty.clear();
+
+    // Entries of finished streams pile up at the front; trim the oldest.
+    while (openOrder.size() > 2 * kMaxOpenFiles) {
+        auto v = streams.find(openOrder.front());
+        openOrder.pop_front();
+        if (v != streams.end() && v->second.file.is_open()) {
+            v->second.file.close();
+            --openFiles;
+        }
+    }
+}
+
+const std::string& LogPipeline::stamp(uint64_t wallMs)
+{
+    if (wallMs == stampMs && !stampText.empty()) return stampText;
+
+    std::time_t tt = static_cast<std::time_t>(wallMs / 1000);
+    std::tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &tt);
+#else
+    localtime_r(&tt, &tm);
+#endif
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02d:%02d:%02d.%03d",
+                  tm.tm_hour, tm.tm_min, tm.tm_sec, static_cast<int>(wallMs % 1000));
+    stampMs   = wallMs;
+    stampText = buf;
+    return stampText;
+}
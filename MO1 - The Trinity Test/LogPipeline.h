@@ -0,0 +1,117 @@
+/* ---------- LogPipeline.h ---------- */
+#ifndef LOGPIPELINE_H
+#define LOGPIPELINE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <unordered_map>
+#include <map>
+#include <deque>
+#include <cstdint>
+#include "Bytecode.h"
+
+/*
+ * Process output pipeline.
+ * Cores push fixed-size binary records into their own single-producer ring;
+ * one writer thread drains the rings, formats the text and appends it to
+ * "<process>.txt" through file handles it keeps open. Nothing here blocks a
+ * core unless its ring is full.
+ */
+enum : uint8_t { LOG_OP = 0, LOG_CLOSE = 1 };
+
+struct LogRecord {
+    uint64_t  wallMs;       // system_clock milliseconds
+    int32_t   pid;
+    uint32_t  seq;          // per-process order, survives core migration
+    uint32_t  line;         // executed lines before this op
+    uint16_t  core;
+    uint8_t   kind;
+    uint8_t   pad;
+    ByteInstr op;
+    uint16_t  value;        // printed register value (PRINT)
+};
+
+class LogRing {
+public:
+    explicit LogRing(std::size_t capacityPow2);
+    bool push(const LogRecord& rec);            // producer side
+    template <typename F> std::size_t drain(F&& fn);  // consumer side
+
+private:
+    std::vector<LogRecord> buf;
+    std::size_t mask;
+    std::atomic<uint64_t> head{0};              // next record to read
+    char pad[64];                               // keep head/tail on separate lines
+    std::atomic<uint64_t> tail{0};              // next slot to write
+};
+
+class LogPipeline {
+public:
+    explicit LogPipeline(int producers);
+    ~LogPipeline();
+
+    // Registers a process's output file and the program its records refer to.
+    void open(int pid, const std::string& name, std::shared_ptr<const Program> code);
+
+    void record(int producer, int pid, uint32_t& seq, uint32_t line,
+                uint16_t core, const ByteInstr& op, uint16_t value);
+    void close(int producer, int pid, uint32_t& seq);
+
+    void stop();
+
+private:
+    struct Stream {
+        std::string name;
+        std::shared_ptr<const Program> code;
+        std::ofstream file;
+        std::string   pending;              // formatted, not yet written
+        uint32_t      nextSeq{0};
+        std::map<uint32_t, LogRecord> early;    // arrived ahead of nextSeq
+        bool          closing{false};
+        bool          dirty{false};
+    };
+    struct Registration {
+        int pid;
+        std::string name;
+        std::shared_ptr<const Program> code;
+    };
+
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::mutex                regMutex;
+    std::vector<Registration> registrations;
+    std::unordered_map<int, Stream> streams;
+    std::vector<int>  dirty;            // streams touched since the last flush
+    std::deque<int>   openOrder;        // pids with an open file, oldest first
+    std::size_t       openFiles{0};
+    std::atomic<bool> running{true};
+    std::thread       writer;
+
+    // once-per-millisecond timestamp cache
+    uint64_t    stampMs{0};
+    std::string stampText;
+
+    void push(int producer, const LogRecord& rec);
+    void writerLoop();
+    void adoptRegistrations();
+    void consume(const LogRecord& rec);
+    void format(Stream& s, const LogRecord& rec);
+    void flushStreams();
+    const std::string& stamp(uint64_t wallMs);
+};
+
+template <typename F>
+std::size_t LogRing::drain(F&& fn)
+{
+    uint64_t h = head.load(std::memory_order_relaxed);
+    const uint64_t t = tail.load(std::memory_order_acquire);
+    for (uint64_t i = h; i < t; ++i) fn(buf[i & mask]);
+    head.store(t, std::memory_order_release);
+    return static_cast<std::size_t>(t - h);
+}
+
+#endif
@@ -0,0 +1,222 @@
+#include "MemoryAllocator.h"
+#include <algorithm>
+#include <climits>
+
+FitPolicy parseFitPolicy(const std::string& name)
+{
+    if (name == "best-fit"  || name == "best")  return FitPolicy::BEST;
+    if (name == "worst-fit" || name == "worst") return FitPolicy::WORST;
+    if (name == "next-fit"  || name == "next")  return FitPolicy::NEXT;
+    return FitPolicy::FIRST;
+}
+
+MemoryAllocator::MemoryAllocator(int totalBytes, int frameBytes, FitPolicy policy)
+    : frames(0), frameBytes(std::max(1, frameBytes)), policy(policy), freeFrames(0)
+{
+    frames     = std::max(0, totalBytes) / this->frameBytes;
+    freeFrames = frames;
+    if (frames > 0) {
+        tree.resize(static_cast<std::size_t>(frames) * 4);
+        build(1, 0, frames - 1);
+        freeByStart.emplace(0, frames);
+        freeBySize.emplace(frames, 0);
+    }
+}
+
+bool MemoryAllocator::allocate(int pid, const std::string& name, int bytes)
+{
+    if (isResident(pid)) return true;
+
+    const int need = std::max(1, framesFor(bytes));
+    if (frames == 0 || need > freeFrames) return false;
+
+    const int start = pick(need);
+    if (start < 0) return false;
+
+    takeRange(start, need);
+    resident.emplace(pid, Block{ start, need, name });
+    if (policy == FitPolicy::NEXT)
+        nextCursor = (start + need) % frames;
+    return true;
+}
+
+void MemoryAllocator::release(int pid)
+{
+    auto it = resident.find(pid);
+    if (it == resident.end()) return;
+    giveRange(it->second.start, it->second.length);
+    resident.erase(it);
+}
+
+bool MemoryAllocator::canFit(int bytes) const
+{
+    return frames > 0 && tree[1].best >= std::max(1, framesFor(bytes));
+}
+
+std::vector<MemoryBlock> MemoryAllocator::blocks() const
+{
+    std::vector<MemoryBlock> out;
+    out.reserve(resident.size());
+    for (const auto& kv : resident) {
+        const Block& b = kv.second;
+        out.push_back(MemoryBlock{ b.start * frameBytes,
+                                   (b.start + b.length) * frameBytes,
+                                   b.name });
+    }
+    std::sort(out.begin(), out.end(),
+              [](const MemoryBlock& a, const MemoryBlock& b) { return a.start < b.start; });
+    return out;
+}
+
+int MemoryAllocator::pick(int need)
+{
+    switch (policy) {
+        case FitPolicy::BEST: {
+            auto it = freeBySize.lower_bound(std::make_pair(need, INT_MIN));
+            return (it != freeBySize.end()) ? it->second : -1;
+        }
+        case FitPolicy::WORST: {
+            if (freeBySize.empty()) return -1;
+            const int largest = std::prev(freeBySize.end())->first;
+            if (largest < need) return -1;
+            return freeBySize.lower_bound(std::make_pair(largest, INT_MIN))->second;
+        }
+        case FitPolicy::NEXT: {
+            int carry = 0;
+            int at = findFrom(1, 0, frames - 1, nextCursor, need, carry);
+            if (at >= 0 || nextCursor == 0) return at;
+            carry = 0;
+            return findFrom(1, 0, frames - 1, 0, need, carry);
+        }
+        case FitPolicy::FIRST:
+        default: {
+            int carry = 0;
+            return findFrom(1, 0, frames - 1, 0, need, carry);
+        }
+    }
+}
+
+void MemoryAllocator::takeRange(int start, int length)
+{
+    auto it = std::prev(freeByStart.upper_bound(start));
+    const int s = it->first, l = it->second;
+    freeBySize.erase(std::make_pair(l, s));
+    freeByStart.erase(it);
+
+    if (start > s) {
+        freeByStart.emplace(s, start - s);
+        freeBySize.emplace(start - s, s);
+    }
+    const int tail = (s + l) - (start + length);
+    if (tail > 0) {
+        freeByStart.emplace(start + length, tail);
+        freeBySize.emplace(tail, start + length);
+    }
+
+    assign(1, 0, frames - 1, start, start + length - 1, false);
+    freeFrames -= length;
+}
+
+void MemoryAllocator::giveRange(int start, int length)
+{
+    assign(1, 0, frames - 1, start, start + length - 1, true);
+    freeFrames += length;
+
+    int s = start, l = length;
+    auto next = freeByStart.lower_bound(start);
+    if (next != freeByStart.end() && next->first == s + l) {
+        l += next->second;
+        freeBySize.erase(std::make_pair(next->second, next->first));
+        next = freeByStart.erase(next);
+    }
+    if (next != freeByStart.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == s) {
+            s  = prev->first;
+            l += prev->second;
+            freeBySize.erase(std::make_pair(prev->second, prev->first));
+            freeByStart.erase(prev);
+        }
+    }
+    freeByStart.emplace(s, l);
+    freeBySize.emplace(l, s);
+}
+
+/* ---------- segment tree ---------- */
+
+void MemoryAllocator::build(int node, int lo, int hi)
+{
+    tree[node].len = hi - lo + 1;
+    tree[node].tag = -1;
+    if (lo == hi) {
+        tree[node].pre = tree[node].suf = tree[node].best = 1;
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    build(node * 2, lo, mid);
+    build(node * 2 + 1, mid + 1, hi);
+    pull(node);
+}
+
+void MemoryAllocator::apply(int node, bool free)
+{
+    Node& n = tree[node];
+    n.pre = n.suf = n.best = free ? n.len : 0;
+    n.tag = free ? 1 : 0;
+}
+
+void MemoryAllocator::pushDown(int node)
+{
+    if (tree[node].tag < 0) return;
+    apply(node * 2, tree[node].tag == 1);
+    apply(node * 2 + 1, tree[node].tag == 1);
+    tree[node].tag = -1;
+}
+
+void MemoryAllocator::pull(int node)
+{
+    const Node& L = tree[node * 2];
+    const Node& R = tree[node * 2 + 1];
+    Node& n = tree[node];
+    n.pre  = (L.pre == L.len) ? L.len + R.pre : L.pre;
+    n.suf  = (R.suf == R.len) ? R.len + L.suf : R.suf;
+    n.best = std::max(std::max(L.best, R.best), L.suf + R.pre);
+}
+
+void MemoryAllocator::assign(int node, int lo, int hi, int from, int to, bool free)
+{
+    if (to < lo || hi < from) return;
+    if (from <= lo && hi <= to) { apply(node, free); return; }
+    pushDown(node);
+    int mid = (lo + hi) / 2;
+    assign(node * 2, lo, mid, from, to, free);
+    assign(node * 2 + 1, mid + 1, hi, from, to, free);
+    pull(node);
+}
+
+// Leftmost start >= from of a free run of `need` frames that lies entirely at
+// or after `from`. `carry` is the free run ending just before `lo`.
+int MemoryAllocator::findFrom(int node, int lo, int hi, int from, int need, int& carry) const
+{
+    if (hi < from) return -1;
+    const Node& n = tree[node];
+
+    if (lo >= from) {
+        if (carry + n.pre >= need) return lo - carry;
+        if (n.best < need || n.tag >= 0 || lo == hi) {
+            carry = (n.pre == n.len) ? carry + n.len : n.suf;
+            return -1;
+        }
+    } else if (n.tag >= 0) {
+        // uniform node straddling `from`; its children may be stale
+        int run = (n.tag == 1) ? hi - from + 1 : 0;
+        if (run >= need) return from;
+        carry = run;
+        return -1;
+    }
+
+    int mid = (lo + hi) / 2;
+    int at = findFrom(node * 2, lo, mid, from, need, carry);
+    if (at >= 0) return at;
+    return findFrom(node * 2 + 1, mid + 1, hi, from, need, carry);
+}
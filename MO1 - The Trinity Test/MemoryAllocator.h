@@ -0,0 +1,73 @@
+/* ---------- MemoryAllocator.h ---------- */
+#ifndef MEMORYALLOCATOR_H
+#define MEMORYALLOCATOR_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+struct MemoryBlock {
+    int start;
+    int end;
+    std::string pid;
+};
+
+enum class FitPolicy { FIRST, BEST, WORST, NEXT };
+
+FitPolicy parseFitPolicy(const std::string& name);     // "first-fit", "best-fit", ...
+
+/*
+ * Frame-granular contiguous allocator.
+ * Free ranges are indexed by start (for coalescing) and by size (best/worst
+ * fit); a segment tree over frames answers first-fit and next-fit. Every
+ * operation is O(log frames); residency is an O(1) lookup by process ID.
+ * Not thread-safe: only the scheduler's clock thread calls it.
+ */
+class MemoryAllocator {
+public:
+    MemoryAllocator(int totalBytes, int frameBytes, FitPolicy policy);
+
+    bool allocate(int pid, const std::string& name, int bytes);
+    void release(int pid);
+    bool isResident(int pid) const { return resident.count(pid) != 0; }
+
+    std::size_t residentCount() const { return resident.size(); }
+    int  totalBytes() const { return frames * frameBytes; }
+    int  freeBytes() const { return freeFrames * frameBytes; }
+    bool canFit(int bytes) const;
+    std::vector<MemoryBlock> blocks() const;           // ascending by start
+
+private:
+    struct Block { int start; int length; std::string name; };
+    struct Node  { int pre; int suf; int best; int len; int8_t tag; };
+
+    int frames;
+    int frameBytes;
+    FitPolicy policy;
+    int freeFrames;
+    int nextCursor{0};
+
+    std::map<int, int> freeByStart;                 // start -> length (frames)
+    std::set<std::pair<int, int>> freeBySize;       // (length, start)
+    std::unordered_map<int, Block> resident;        // pid -> block
+    std::vector<Node> tree;
+
+    int  framesFor(int bytes) const { return (bytes + frameBytes - 1) / frameBytes; }
+    int  pick(int need);
+    void takeRange(int start, int length);
+    void giveRange(int start, int length);
+
+    // segment tree over frames: longest free run, with lazy range assignment
+    void build(int node, int lo, int hi);
+    void assign(int node, int lo, int hi, int from, int to, bool free);
+    void apply(int node, bool free);
+    void pushDown(int node);
+    void pull(int node);
+    int  findFrom(int node, int lo, int hi, int from, int need, int& carry) const;
+};
+
+#endif
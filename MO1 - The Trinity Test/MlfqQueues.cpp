@@ -0,0 +1,83 @@
+#include "MlfqQueues.h"
+#include "ProcessRegistry.h"
+#include <algorithm>
+
+static_assert(kMlfqMaxLevels <= 32, "the level bitmap is one 32-bit word");
+
+MlfqQueues::MlfqQueues(ProcessRegistry& registry, int levels, int boostCycles)
+    : registry(registry),
+      numLevels(std::min(std::max(1, levels), kMlfqMaxLevels)),
+      boostCycles(static_cast<uint64_t>(std::max(1, boostCycles))) {}
+
+void MlfqQueues::enqueue(ProcessHandle h)
+{
+    ProcessInfo& p = registry[h];
+    if (p.mlfqEpoch != epoch) {
+        p.mlfqEpoch = epoch;
+        p.mlfqLevel = 0;
+    }
+    const int level = std::min(std::max(p.mlfqLevel, 0), numLevels - 1);
+    levels[level].push_back(h);
+    nonEmpty |= 1u << level;
+}
+
+void MlfqQueues::push(int, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    enqueue(h);
+}
+
+void MlfqQueues::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (const auto& q : dealt)
+        for (ProcessHandle h : q) enqueue(h);
+}
+
+bool MlfqQueues::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (uint32_t rest = nonEmpty; rest; rest &= rest - 1) {
+        const int level = lowestSetBit(rest);
+        auto& q = levels[level];
+        auto it = std::find_if(q.begin(), q.end(),
+                               [&](ProcessHandle h) { return registry[h].allowedOn(queueIdx + 1); });
+        if (it == q.end()) continue;
+        out = *it;
+        q.erase(it);
+        if (q.empty()) nonEmpty &= ~(1u << level);
+        return true;
+    }
+    return false;
+}
+
+void MlfqQueues::tick(uint64_t now)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    if (now - lastBoost < boostCycles) return;
+    lastBoost = now;
+    ++epoch;
+
+    // Lower levels go behind level 0 in level order, so relative order holds.
+    auto& top = levels[0];
+    for (int level = 1; level < numLevels; ++level) {
+        for (ProcessHandle h : levels[level]) top.push_back(h);
+        levels[level].clear();
+    }
+    for (ProcessHandle h : top) {
+        ProcessInfo& p = registry[h];
+        p.mlfqEpoch = epoch;
+        p.mlfqLevel = 0;
+    }
+    nonEmpty = top.empty() ? 0u : 1u;
+}
+
+void MlfqQueues::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (uint32_t rest = nonEmpty; rest && out.size() < n; rest &= rest - 1)
+        for (ProcessHandle h : levels[lowestSetBit(rest)]) {
+            if (out.size() == n) return;
+            out.push_back(h);
+        }
+}
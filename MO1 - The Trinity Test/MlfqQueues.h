@@ -0,0 +1,47 @@
+/* ---------- MlfqQueues.h ---------- */
+#ifndef MLFQQUEUES_H
+#define MLFQQUEUES_H
+
+#include <deque>
+#include <mutex>
+#include <cstdint>
+#include "ReadyQueue.h"
+#include "ProcessInfo.h"
+
+class ProcessRegistry;
+
+/*
+ * Multi-level feedback queue: one FIFO per level, shared by all cores,
+ * with a bitmap of the non-empty ones; pop() serves the top level first.
+ * MlfqPolicy moves a process between levels as it leaves a core; this
+ * class only files it under its current level.
+ *
+ * Every boostCycles the queue resets everyone to level 0: queued entries
+ * move at once, processes that are running or asleep pick the reset up
+ * the next time they are queued (their mlfqEpoch is behind).
+ */
+class MlfqQueues final : public ReadyQueue {
+public:
+    MlfqQueues(ProcessRegistry& registry, int levels, int boostCycles);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+    void tick(uint64_t now) override;
+
+private:
+    ProcessRegistry& registry;
+    const int        numLevels;
+    const uint64_t   boostCycles;
+
+    std::mutex mx;
+    uint32_t   nonEmpty{0};                 // bit l set: levels[l] has entries
+    std::deque<ProcessHandle> levels[kMlfqMaxLevels];
+    uint32_t   epoch{0};                    // boosts so far
+    uint64_t   lastBoost{0};
+
+    void enqueue(ProcessHandle h);          // caller holds mx
+};
+
+#endif
@@ -0,0 +1,118 @@
+/* ---------- PcbSlab.h ---------- */
+#ifndef PCBSLAB_H
+#define PCBSLAB_H
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "ProcessInfo.h"
+#include "ProcessStatus.h"
+
+/*
+ * Chunked slab of process control blocks, each paired with the StatusCell
+ * monitors read. Chunks are never moved or freed while the slab lives, so a
+ * handle stays valid until release() hands its slot back for reuse. Lookup
+ * is two array indexes and takes no lock; emplace() and release() serialise
+ * on the free list.
+ */
+class PcbSlab {
+public:
+    PcbSlab() {
+        for (auto& c : chunks) c.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~PcbSlab() {
+        const uint32_t n = used.load();
+        for (uint32_t h = 0; h < n; ++h)
+            if (status(h).read().state != ProcState::FREE) (*this)[h].~ProcessInfo();
+        for (auto& c : chunks) delete c.load();
+    }
+
+    PcbSlab(const PcbSlab&) = delete;
+    PcbSlab& operator=(const PcbSlab&) = delete;
+
+    ProcessHandle emplace(ProcessInfo&& proc)
+    {
+        std::lock_guard<std::mutex> lk(growMutex);
+        const bool     reuse = !freeList.empty();
+        const uint32_t h     = reuse ? freeList.back() : used.load(std::memory_order_relaxed);
+        if (h >= kChunkSize * kMaxChunks) return kNoProcess;
+        if (reuse) {
+            freeList.pop_back();
+            freeCount.store(static_cast<uint32_t>(freeList.size()), std::memory_order_release);
+        }
+
+        Chunk* chunk = chunks[h >> kChunkBits].load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new Chunk;
+            chunks[h >> kChunkBits].store(chunk, std::memory_order_release);
+        }
+        ProcessInfo* pcb = new (&chunk->slot[h & (kChunkSize - 1)]) ProcessInfo(std::move(proc));
+
+        ProcessStatus st;
+        st.handle = h;
+        st.pid    = pcb->processID;
+        st.total  = static_cast<uint32_t>(pcb->totalLine);
+        chunk->status[h & (kChunkSize - 1)].publish(st);
+
+        if (!reuse) used.store(h + 1, std::memory_order_release);
+        return h;
+    }
+
+    // Destroys the PCB and recycles its slot. The caller guarantees nobody
+    // else still reads it (see ProcessRegistry::erase).
+    void release(ProcessHandle h)
+    {
+        ProcessStatus st;
+        st.state = ProcState::FREE;
+        status(h).publish(st);
+        (*this)[h].~ProcessInfo();
+
+        std::lock_guard<std::mutex> lk(growMutex);
+        freeList.push_back(h);
+        freeCount.store(static_cast<uint32_t>(freeList.size()), std::memory_order_release);
+    }
+
+    ProcessInfo& operator[](ProcessHandle h) const
+    {
+        Chunk* chunk = chunks[h >> kChunkBits].load(std::memory_order_acquire);
+        return *reinterpret_cast<ProcessInfo*>(&chunk->slot[h & (kChunkSize - 1)]);
+    }
+
+    StatusCell& status(ProcessHandle h) const
+    {
+        Chunk* chunk = chunks[h >> kChunkBits].load(std::memory_order_acquire);
+        return chunk->status[h & (kChunkSize - 1)];
+    }
+
+    // Slots ever handed out, free ones included; live() is what is in use.
+    uint32_t size() const { return used.load(std::memory_order_acquire); }
+    uint32_t live() const
+    {
+        const uint32_t freed = freeCount.load(std::memory_order_acquire);
+        return used.load(std::memory_order_acquire) - freed;
+    }
+
+private:
+    static constexpr uint32_t kChunkBits = 10;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits;     // PCBs per chunk
+    static constexpr uint32_t kMaxChunks = 1u << 12;             // 4M PCBs in all
+
+    struct Chunk {
+        typename std::aligned_storage<sizeof(ProcessInfo), alignof(ProcessInfo)>::type
+            slot[kChunkSize];
+        StatusCell status[kChunkSize];
+    };
+
+    std::atomic<Chunk*>   chunks[kMaxChunks];
+    std::atomic<uint32_t> used{0};
+    std::atomic<uint32_t> freeCount{0};
+    std::vector<ProcessHandle> freeList;
+    std::mutex            growMutex;
+};
+
+#endif
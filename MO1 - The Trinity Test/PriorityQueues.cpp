@@ -0,0 +1,76 @@
+#include "PriorityQueues.h"
+#include "ProcessRegistry.h"
+#include <algorithm>
+
+static_assert(kPriorityLevels <= 32, "the level bitmap is one 32-bit word");
+
+PriorityQueues::PriorityQueues(ProcessRegistry& registry, int agingCycles)
+    : registry(registry), agingCycles(static_cast<uint64_t>(std::max(1, agingCycles))) {}
+
+void PriorityQueues::enqueue(ProcessHandle h)
+{
+    const int level = std::min(std::max(registry[h].priority, 0), kPriorityLevels - 1);
+    levels[level].push_back(Entry{ h, now });
+    nonEmpty |= 1u << level;
+}
+
+void PriorityQueues::push(int, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    enqueue(h);
+}
+
+void PriorityQueues::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (const auto& q : dealt)
+        for (ProcessHandle h : q) enqueue(h);
+}
+
+bool PriorityQueues::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (uint32_t rest = nonEmpty; rest; rest &= rest - 1) {
+        const int level = lowestSetBit(rest);
+        auto& q = levels[level];
+        auto it = std::find_if(q.begin(), q.end(),
+                               [&](const Entry& e) { return registry[e.h].allowedOn(queueIdx + 1); });
+        if (it == q.end()) continue;
+        out = it->h;
+        q.erase(it);
+        if (q.empty()) nonEmpty &= ~(1u << level);
+        return true;
+    }
+    return false;
+}
+
+void PriorityQueues::tick(uint64_t cycle)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    now = cycle;
+    if (now - lastAging < agingCycles) return;
+    lastAging = now;
+
+    // Each level is ordered by arrival there, so only its stale prefix moves.
+    // Going top-down, an entry climbs at most one level per aging pass.
+    for (int level = 1; level < kPriorityLevels; ++level) {
+        auto& q  = levels[level];
+        auto& up = levels[level - 1];
+        while (!q.empty() && now - q.front().since >= agingCycles) {
+            up.push_back(Entry{ q.front().h, now });
+            q.pop_front();
+            nonEmpty |= 1u << (level - 1);
+        }
+        if (q.empty()) nonEmpty &= ~(1u << level);
+    }
+}
+
+void PriorityQueues::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (uint32_t rest = nonEmpty; rest && out.size() < n; rest &= rest - 1)
+        for (const Entry& e : levels[lowestSetBit(rest)]) {
+            if (out.size() == n) return;
+            out.push_back(e.h);
+        }
+}
@@ -0,0 +1,49 @@
+/* ---------- PriorityQueues.h ---------- */
+#ifndef PRIORITYQUEUES_H
+#define PRIORITYQUEUES_H
+
+#include <deque>
+#include <mutex>
+#include <cstdint>
+#include "ReadyQueue.h"
+#include "ProcessInfo.h"
+
+class ProcessRegistry;
+
+/*
+ * One FIFO per priority level plus a bitmap of the non-empty ones, shared
+ * by all cores. pop() takes the front of the lowest set bit (find-first-set),
+ * so picking is O(1) however many processes are ready. Aging: every
+ * agingCycles, entries that have waited that long on their level move up
+ * one, so low priorities cannot starve; a process goes back to its own
+ * priority when it is next queued.
+ */
+class PriorityQueues final : public ReadyQueue {
+public:
+    PriorityQueues(ProcessRegistry& registry, int agingCycles);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+    void tick(uint64_t now) override;
+
+private:
+    struct Entry {
+        ProcessHandle h;
+        uint64_t      since;        // cycle it reached this level
+    };
+
+    ProcessRegistry& registry;
+    const uint64_t   agingCycles;
+
+    std::mutex mx;
+    uint32_t   nonEmpty{0};                 // bit l set: levels[l] has entries
+    std::deque<Entry> levels[kPriorityLevels];
+    uint64_t   now{0};
+    uint64_t   lastAging{0};
+
+    void enqueue(ProcessHandle h);          // caller holds mx
+};
+
+#endif
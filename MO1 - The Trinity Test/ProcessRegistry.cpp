@@ -0,0 +1,67 @@
+#include "ProcessRegistry.h"
+
+ProcessHandle ProcessRegistry::insert(ProcessInfo&& proc)
+{
+    // Both shard locks are held until the handle is published so a concurrent
+    // insert of the same name or PID cannot slip in between check and claim.
+    NameShard& ns = byName[nameShard(proc.processName)];
+    std::lock_guard<std::mutex> nlk(ns.mx);
+    if (ns.index.count(proc.processName))
+        return kNoProcess;
+
+    PidShard& ps = byPid[pidShard(proc.processID)];
+    std::lock_guard<std::mutex> plk(ps.mx);
+    if (ps.index.count(proc.processID))
+        return kNoProcess;
+
+    const std::string name = proc.processName;
+    const int         pid  = proc.processID;
+    ProcessHandle h = slab.emplace(std::move(proc));
+    if (h == kNoProcess)
+        return kNoProcess;
+
+    ns.index.emplace(name, h);
+    ps.index.emplace(pid, h);
+    return h;
+}
+
+ProcessHandle ProcessRegistry::findByName(const std::string& name) const
+{
+    const NameShard& ns = byName[nameShard(name)];
+    std::lock_guard<std::mutex> lk(ns.mx);
+    auto it = ns.index.find(name);
+    return (it != ns.index.end()) ? it->second : kNoProcess;
+}
+
+ProcessHandle ProcessRegistry::findByPid(int pid) const
+{
+    const PidShard& ps = byPid[pidShard(pid)];
+    std::lock_guard<std::mutex> lk(ps.mx);
+    auto it = ps.index.find(pid);
+    return (it != ps.index.end()) ? it->second : kNoProcess;
+}
+
+void ProcessRegistry::erase(ProcessHandle h)
+{
+    std::unique_lock<std::shared_timed_mutex> ex(reclaim);
+
+    const ProcessInfo& p = slab[h];
+    {
+        NameShard& ns = byName[nameShard(p.processName)];
+        std::lock_guard<std::mutex> lk(ns.mx);
+        ns.index.erase(p.processName);
+    }
+    {
+        PidShard& ps = byPid[pidShard(p.processID)];
+        std::lock_guard<std::mutex> lk(ps.mx);
+        ps.index.erase(p.processID);
+    }
+    slab.release(h);
+}
+
+void ProcessRegistry::forEach(const std::function<void(ProcessHandle)>& fn) const
+{
+    const uint32_t n = slab.size();
+    for (ProcessHandle h = 0; h < n; ++h)
+        if (slab.status(h).read().state != ProcState::FREE) fn(h);
+}
@@ -0,0 +1,70 @@
+/* ---------- ProcessRegistry.h ---------- */
+#ifndef PROCESSREGISTRY_H
+#define PROCESSREGISTRY_H
+
+#include <string>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <functional>
+#include "ProcessInfo.h"
+#include "PcbSlab.h"
+
+/*
+ * Owner of every live process control block.
+ * PCBs live in a PcbSlab and are addressed by 32-bit handles; two sharded
+ * hash indexes (name and PID) map to those handles with O(1) lookups that
+ * only lock one shard. Finished processes are erased once archived, so
+ * readers that are not the process's current holder (monitors) must keep
+ * a readGuard() while they look at a PCB.
+ */
+class ProcessRegistry {
+public:
+    // Takes ownership; returns kNoProcess if the name or PID is already taken.
+    ProcessHandle insert(ProcessInfo&& proc);
+
+    ProcessHandle findByName(const std::string& name) const;
+    ProcessHandle findByPid(int pid) const;
+    bool contains(const std::string& name) const { return findByName(name) != kNoProcess; }
+
+    // Drops the indexes and recycles the slot; waits out current readers.
+    void erase(ProcessHandle h);
+
+    ProcessInfo& operator[](ProcessHandle h) const { return slab[h]; }
+    StatusCell&  status(ProcessHandle h) const { return slab.status(h); }
+    std::size_t size() const { return slab.live(); }
+
+    std::shared_lock<std::shared_timed_mutex> readGuard() const {
+        return std::shared_lock<std::shared_timed_mutex>(reclaim);
+    }
+
+    // Visits every live handle in slot order. Statuses are always safe to
+    // read; dereferencing the PCB needs the caller to hold readGuard().
+    void forEach(const std::function<void(ProcessHandle)>& fn) const;
+
+private:
+    static constexpr std::size_t kShards = 16;
+
+    struct NameShard {
+        mutable std::mutex mx;
+        std::unordered_map<std::string, ProcessHandle> index;
+    };
+    struct PidShard {
+        mutable std::mutex mx;
+        std::unordered_map<int, ProcessHandle> index;
+    };
+
+    PcbSlab   slab;
+    mutable std::shared_timed_mutex reclaim;
+    NameShard byName[kShards];
+    PidShard  byPid[kShards];
+
+    static std::size_t nameShard(const std::string& name) {
+        return std::hash<std::string>()(name) % kShards;
+    }
+    static std::size_t pidShard(int pid) {
+        return static_cast<std::size_t>(pid) % kShards;
+    }
+};
+
+#endif
@@ -0,0 +1,87 @@
+/* ---------- ProcessStatus.h ---------- */
+#ifndef PROCESSSTATUS_H
+#define PROCESSSTATUS_H
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+// 32-bit index of a PCB in the slab; what every scheduler queue stores.
+using ProcessHandle = uint32_t;
+constexpr ProcessHandle kNoProcess = 0xFFFFFFFFu;
+
+enum class ProcState : uint8_t { READY, RUNNING, SLEEPING, MEMWAIT, FINISHED, FREE };
+
+// What monitors (screen -ls, report-util, process-smi) need to know about a
+// process; the name and creation timestamp are immutable and read off the PCB.
+struct ProcessStatus {
+    ProcessHandle handle{kNoProcess};
+    int32_t   pid{-1};
+    ProcState state{ProcState::READY};
+    int16_t   core{-1};             // current or last core, -1 if never run
+    uint32_t  migrations{0};        // dispatches that changed core
+    uint32_t  executed{0};
+    uint32_t  total{0};
+    uint64_t  finishedCycle{0};     // CPU cycle it finished on, 0 while live
+};
+
+/*
+ * Seqlock around one ProcessStatus.
+ * Exactly one thread writes a cell at a time: whoever currently holds the
+ * process (its core, the clock waking it, the creator). Readers never block
+ * the writer; they retry if a write overlapped their read.
+ */
+class StatusCell {
+public:
+    void publish(const ProcessStatus& s)
+    {
+        const uint32_t v = seq.load(std::memory_order_relaxed);
+        seq.store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        handle.store(s.handle, std::memory_order_relaxed);
+        pid.store(s.pid, std::memory_order_relaxed);
+        state.store(static_cast<uint8_t>(s.state), std::memory_order_relaxed);
+        core.store(s.core, std::memory_order_relaxed);
+        migrations.store(s.migrations, std::memory_order_relaxed);
+        executed.store(s.executed, std::memory_order_relaxed);
+        total.store(s.total, std::memory_order_relaxed);
+        finishedCycle.store(s.finishedCycle, std::memory_order_relaxed);
+
+        seq.store(v + 2, std::memory_order_release);
+    }
+
+    ProcessStatus read() const
+    {
+        ProcessStatus s;
+        for (;;) {
+            const uint32_t v1 = seq.load(std::memory_order_acquire);
+            if (v1 & 1u) { std::this_thread::yield(); continue; }
+
+            s.handle        = handle.load(std::memory_order_relaxed);
+            s.pid           = pid.load(std::memory_order_relaxed);
+            s.state         = static_cast<ProcState>(state.load(std::memory_order_relaxed));
+            s.core          = core.load(std::memory_order_relaxed);
+            s.migrations    = migrations.load(std::memory_order_relaxed);
+            s.executed      = executed.load(std::memory_order_relaxed);
+            s.total         = total.load(std::memory_order_relaxed);
+            s.finishedCycle = finishedCycle.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == v1) return s;
+        }
+    }
+
+private:
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> handle{kNoProcess};
+    std::atomic<int32_t>  pid{-1};
+    std::atomic<uint8_t>  state{0};
+    std::atomic<int16_t>  core{-1};
+    std::atomic<uint32_t> migrations{0};
+    std::atomic<uint32_t> executed{0};
+    std::atomic<uint32_t> total{0};
+    std::atomic<uint64_t> finishedCycle{0};
+};
+
+#endif
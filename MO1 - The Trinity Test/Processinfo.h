@@ -3,40 +3,73 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <cstdint>
-#include "Instruction.h"
+#include <memory>
+#include "Bytecode.h"
+
+// Scheduling priority: 0 is the most urgent, kPriorityLevels - 1 the least.
+constexpr int kPriorityLevels  = 32;
+constexpr int kDefaultPriority = kPriorityLevels / 2;
+
+// Most feedback-queue levels the mlfq scheduler supports.
+constexpr int kMlfqMaxLevels = 8;
 
 struct ProcessInfo
 {
+    // Members are grouped so the 4-byte ones pair up; the PCB is 208 bytes
+    // in 64-bit builds, and allocates nothing itself unless its name
+    // outgrows the string's inline buffer.
     int         processID;
+    int         totalLine{0};
     std::string processName;
 
-    int  totalLine{0};
     int  currentLine{0};
     int  executedLines{0};
-    int  assignedCore{-1};
-    std::string timeStamp;
-    bool isFinished{false};
+    int  assignedCore{-1};      // core it runs on, or last ran on
     int  sleepTicks{0};
+    int64_t createdMs{0};       // wall-clock creation, see Data::formatTimestamp
+    int  priority{kDefaultPriority};
+    bool isFinished{false};
+    uint64_t vruntime{0};       // fair scheduler: instruction ticks run, see CfsQueue
+    int      mlfqLevel{0};      // feedback queue level, 0 the top; see MlfqQueues
+    uint32_t mlfqEpoch{0};      // last boost the level was reset for
+
+    // Completion deadline, if any: relDeadline ticks after arrival, set by
+    // whoever creates the process; admission fills in the absolute cycle.
+    uint32_t relDeadline{0};
+    uint32_t reservedWork{0};   // ticks still counted against the deadline load
+    uint64_t deadline{0};
 
-    std::vector<Instruction> prog;
-    std::unordered_map<std::string,uint16_t> vars;
+    // Hard affinity: bit c-1 set if core c may run it; 0 allows any core.
+    uint64_t affinity{0};
+    uint32_t migrations{0};     // dispatches on a different core than the last one
 
-    struct LoopFrame { int start; int end; uint16_t remain; int indent; };
-    std::vector<LoopFrame> loopStack;
+    // Until first dispatch only the generator inputs are kept; the scheduler
+    // builds code from them (see ProgramGenerator.h).
+    int      programSize{0};
+    uint64_t seed{0};
 
-    std::vector<std::string> outBuf;
+    std::shared_ptr<const Program> code;    // immutable; currentLine is its pc
+    std::vector<uint16_t>  regs;            // register file, one slot per variable
+    std::vector<LoopFrame> loopStack;       // active FOR frames, innermost last
+
+    uint64_t arrivalCycle{0};               // CPU cycle it was admitted on
+    uint32_t logSeq{0};                     // next output record, see LogPipeline
+
+    bool allowedOn(int core) const
+    {
+        return !affinity || (core >= 1 && core <= 64 && ((affinity >> (core - 1)) & 1u));
+    }
 
     ProcessInfo(int id,
                 const std::string& name,
                 int lines,
-                const std::string& ts,
+                int64_t created,
                 bool finished = false)
         : processID(id),
-          processName(name),
           totalLine(lines),
-          timeStamp(ts),
+          processName(name),
+          createdMs(created),
           isFinished(finished) {}
 };
 
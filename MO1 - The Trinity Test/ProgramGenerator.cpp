@@ -0,0 +1,117 @@
+#include "ProgramGenerator.h"
+#include "Instruction.h"
+#include "Rng.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+std::string randVar(Xoshiro256& rng)
+{
+    return std::string(1, static_cast<char>('a' + (rng() % 26)));
+}
+
+Instruction makeLeafInstr(Xoshiro256& rng, std::vector<std::string>& vars)
+{
+    int code = rng() % 5;
+
+    /* ---------- PRINT ---------- */
+    if (code == 0) {
+        /* 50 % chance to emit a blank PRINT */
+        if (rng() & 1)
+            return Instruction(OpCode::PRINT, "\"\"", "", "", false, false);
+
+        if (vars.empty()) return makeLeafInstr(rng, vars);
+        std::string v = vars[rng() % vars.size()];
+        return Instruction(OpCode::PRINT, "\"Value from: \"", v, "", false, true);
+    }
+
+    /* ---------- DECLARE ---------- */
+    if (code == 1) {
+        std::string v = randVar(rng); vars.push_back(v);
+        return Instruction(OpCode::DECLARE, v,
+                           std::to_string(rng.between(0, 65535)));
+    }
+
+    /* ---------- ADD / SUB ---------- */
+    if (code == 2 || code == 3) {
+        if (vars.empty()) return makeLeafInstr(rng, vars);
+        std::string v1 = vars[rng() % vars.size()];
+        std::string a2 = std::to_string(rng.between(1, 500));
+        std::string a3 = std::to_string(rng.between(1, 500));
+        return Instruction(code == 2 ? OpCode::ADD : OpCode::SUBTRACT,
+                           v1, a2, a3);
+    }
+
+    /* ---------- SLEEP ---------- */
+    return Instruction(OpCode::SLEEP, "",
+                       std::to_string(rng.between(1, 5)));
+}
+
+// Cost is the logical (executed) size, tracked as the program grows so
+// generation stays linear in maxLogical. Leaves always fit, so a program
+// built for maxLogical executes exactly that many ticks.
+std::vector<Instruction>
+buildRandomProgram(int                       maxLogical,
+                   Xoshiro256&               rng,
+                   std::vector<std::string>& vars,
+                   std::size_t&              used,
+                   int                       depth      = 3,
+                   int                       fixedBody  = 3)
+{
+    std::vector<Instruction> prog;
+    const std::size_t limit = static_cast<std::size_t>(std::max(maxLogical, 0));
+    used = 0;
+
+    while (used < limit)
+    {
+        bool makeLoop = depth > 0 && (rng() % 4 == 0);
+        Instruction next;
+        std::size_t cost = 1;
+
+        if (makeLoop)
+        {
+            uint8_t reps = static_cast<uint8_t>(rng.between(2, 3));
+            std::size_t bodyCost = 0;
+            auto body    = buildRandomProgram(fixedBody, rng, vars, bodyCost,
+                                              depth - 1, fixedBody);
+
+            // The FOR's own LOOP_INIT tick counts too, as compileProgram
+            // counts it, so the budget is the program's execCount.
+            if (used + 1 + bodyCost * reps <= limit) {
+                next = Instruction(std::move(body), reps);
+                cost = 1 + bodyCost * reps;
+            }
+            else
+                makeLoop = false;
+        }
+
+        if (!makeLoop)
+        {
+            next = makeLeafInstr(rng, vars);
+            cost = 1;
+            if (used + cost > limit) break;
+        }
+
+        prog.emplace_back(std::move(next));
+        used += cost;
+    }
+    return prog;
+}
+
+} // namespace
+
+std::shared_ptr<const Program> generateProgram(uint64_t seed, int maxLogical)
+{
+    Xoshiro256 rng{ seed };
+    std::vector<std::string> vars;
+    std::size_t used = 0;
+    return std::make_shared<const Program>(
+        compileProgram(buildRandomProgram(maxLogical, rng, vars, used)));
+}
+
+uint64_t programSeed(int pid)
+{
+    return Rng::derive(Rng::kProgramStream + static_cast<uint32_t>(pid));
+}
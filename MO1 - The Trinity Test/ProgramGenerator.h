@@ -0,0 +1,20 @@
+/* ---------- ProgramGenerator.h ---------- */
+#ifndef PROGRAMGENERATOR_H
+#define PROGRAMGENERATOR_H
+
+#include <memory>
+#include <cstdint>
+#include "Bytecode.h"
+
+/*
+ * Random dummy-process programs, reproducible from a seed.
+ * A queued process keeps only (seed, size); the scheduler calls this on the
+ * process's first dispatch, and the same pair always yields the same program.
+ * Thread-safe: every call draws from its own engine.
+ */
+std::shared_ptr<const Program> generateProgram(uint64_t seed, int maxLogical);
+
+// Seed for process pid's program; a function of the master seed and pid only.
+uint64_t programSeed(int pid);
+
+#endif
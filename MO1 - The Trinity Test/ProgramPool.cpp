@@ -0,0 +1,88 @@
+#include "ProgramPool.h"
+#include "ProgramGenerator.h"
+#include <algorithm>
+
+ProgramPool::ProgramPool(unsigned workers, std::size_t depth) : depth(depth ? depth : 1)
+{
+    for (unsigned i = 0; i < workers; ++i)
+        threads.emplace_back(&ProgramPool::workerLoop, this);
+}
+
+ProgramPool::~ProgramPool()
+{
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        running = false;
+    }
+    cv.notify_all();
+    for (auto& t : threads)
+        if (t.joinable()) t.join();
+}
+
+// Both queues stay bounded: pending is at most one list long, and ready
+// gives up programs nobody is about to run once it reaches depth.
+void ProgramPool::want(const std::vector<ProgramRequest>& upcoming)
+{
+    if (threads.empty()) return;
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        pending.clear();
+        wanted.clear();
+        for (const ProgramRequest& r : upcoming) {
+            wanted.insert(r.pid);
+            if (!ready.count(r.pid) && !building.count(r.pid))
+                pending.push_back(r);
+        }
+
+        if (ready.size() + building.size() >= depth)
+            for (auto it = ready.begin(); it != ready.end(); )
+                it = wanted.count(it->first) ? std::next(it) : ready.erase(it);
+    }
+    cv.notify_all();
+}
+
+std::shared_ptr<const Program> ProgramPool::take(int pid, uint64_t seed, int size)
+{
+    {
+        std::lock_guard<std::mutex> lk(mx);
+        auto it = ready.find(pid);
+        if (it != ready.end()) {
+            std::shared_ptr<const Program> code = std::move(it->second);
+            ready.erase(it);
+            cv.notify_one();        // room for one more
+            return code;
+        }
+        // Not built yet: the worker building it will drop it, and one that
+        // has not started never sees it.
+        if (building.count(pid))
+            claimed.insert(pid);
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                     [&](const ProgramRequest& r) { return r.pid == pid; }),
+                      pending.end());
+    }
+    return generateProgram(seed, size);
+}
+
+void ProgramPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lk(mx);
+
+    for (;;) {
+        cv.wait(lk, [&]{
+            return !running || (!pending.empty() && ready.size() + building.size() < depth);
+        });
+        if (!running) return;
+
+        const ProgramRequest req = pending.front();
+        pending.pop_front();
+
+        building.insert(req.pid);
+        lk.unlock();
+        std::shared_ptr<const Program> code = generateProgram(req.seed, req.size);
+        lk.lock();
+        building.erase(req.pid);
+
+        if (!claimed.erase(req.pid))
+            ready.emplace(req.pid, std::move(code));
+    }
+}
@@ -0,0 +1,60 @@
+/* ---------- ProgramPool.h ---------- */
+#ifndef PROGRAMPOOL_H
+#define PROGRAMPOOL_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <cstdint>
+#include "Bytecode.h"
+
+// A seeded process whose program is not built yet.
+struct ProgramRequest {
+    int      pid;
+    uint64_t seed;
+    int      size;
+};
+
+/*
+ * Background generation of seeded programs ahead of their first dispatch.
+ * The clock hands over the unbuilt processes at the head of the policy's
+ * ready order every few cycles; that list replaces the previous one, and
+ * workers build it front first while fewer than `depth` programs are ready
+ * or being built. Once the ready map is full, programs for processes that
+ * dropped out of the list make room. take() hands a ready program over, or
+ * builds it inline if the workers have not reached it yet. Programs are
+ * keyed by process ID, so two processes whose seeds happen to match never
+ * trade programs.
+ */
+class ProgramPool {
+public:
+    ProgramPool(unsigned workers, std::size_t depth);
+    ~ProgramPool();
+
+    ProgramPool(const ProgramPool&) = delete;
+    ProgramPool& operator=(const ProgramPool&) = delete;
+
+    void want(const std::vector<ProgramRequest>& upcoming);     // next to run first
+    std::shared_ptr<const Program> take(int pid, uint64_t seed, int size);
+
+private:
+    const std::size_t depth;
+    std::mutex mx;
+    std::condition_variable cv;
+    std::deque<ProgramRequest> pending;             // the latest want(), not yet built
+    std::unordered_map<int, std::shared_ptr<const Program>> ready;   // by pid
+    std::unordered_set<int> building;               // being built by a worker
+    std::unordered_set<int> claimed;                // built inline while a worker builds it
+    std::unordered_set<int> wanted;                 // pids in the latest want(); scratch
+    bool running{true};
+    std::vector<std::thread> threads;
+
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "ReadyQueue.h"
+#include "ProcessRegistry.h"
+#include <algorithm>
+
+FifoQueues::FifoQueues(ProcessRegistry& registry, int n)
+    : registry(registry), queues(static_cast<std::size_t>(std::max(1, n)))
+{
+}
+
+void FifoQueues::push(int queueIdx, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    queues[queueIdx].push_back(h);
+}
+
+void FifoQueues::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (std::size_t q = 0; q < dealt.size() && q < queues.size(); ++q)
+        queues[q].insert(queues[q].end(), dealt[q].begin(), dealt[q].end());
+}
+
+// Own queue first, then the others from the next core on. Takes the oldest
+// entry this core may run either way, so arrival order (FCFS) is preserved.
+bool FifoQueues::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    const int n = static_cast<int>(queues.size());
+    for (int k = 0; k < n; ++k) {
+        std::deque<ProcessHandle>& q = queues[(queueIdx + k) % n];
+        auto it = std::find_if(q.begin(), q.end(),
+                               [&](ProcessHandle h) { return registry[h].allowedOn(queueIdx + 1); });
+        if (it == q.end()) continue;
+        out = *it;
+        q.erase(it);
+        return true;
+    }
+    return false;
+}
+
+// Fronts first, then second entries, and so on, interleaved in core order.
+void FifoQueues::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (std::size_t depth = 0; out.size() < n; ++depth) {
+        bool any = false;
+        for (const auto& q : queues) {
+            if (depth >= q.size()) continue;
+            any = true;
+            out.push_back(q[depth]);
+            if (out.size() == n) return;
+        }
+        if (!any) return;
+    }
+}
@@ -0,0 +1,122 @@
+/* ---------- ReadyQueue.h ---------- */
+#ifndef READYQUEUE_H
+#define READYQUEUE_H
+
+#include <deque>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <mutex>
+#include <memory>
+#include "ProcessStatus.h"
+
+class ProcessRegistry;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * The ready set a scheduling policy picks from.
+ * Queue indexes are core IDs minus one; a discipline may keep one queue
+ * per core or ignore the index and share one. Only the clock thread pops,
+ * dispatching through its policy's concrete (final) queue type; the virtual
+ * interface serves retire, wake-ups and admission. Admission pushes from
+ * the command and batch threads, so each discipline keeps one lock.
+ */
+class ReadyQueue {
+public:
+    virtual ~ReadyQueue() = default;
+
+    virtual void push(int queueIdx, ProcessHandle h) = 0;
+
+    // The next entry, in pop order, that core queueIdx + 1 may run. Entries
+    // pinned to other cores are passed over where they stand, so they keep
+    // their place in line and whatever the discipline keeps for them.
+    virtual bool pop(int queueIdx, ProcessHandle& out) = 0;
+
+    // One call per batch; dealt[q] goes to queue q.
+    virtual void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) = 0;
+
+    // Up to n queued handles, in the order pops would take them, without
+    // taking them; the program pool builds ahead from this.
+    virtual void peek(std::size_t n, std::vector<ProcessHandle>& out) = 0;
+
+    // Called by the clock between cycles, for disciplines that age entries.
+    virtual void tick(uint64_t now) { (void)now; }
+};
+
+// Index of the lowest set bit of a non-zero word (find-first-set).
+inline int lowestSetBit(uint32_t x)
+{
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return static_cast<int>(i);
+#else
+    return __builtin_ctz(x);
+#endif
+}
+
+// Min-heap (by Entry::operator>) whose array peek() may read.
+template <class Entry>
+struct MinHeap : std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> {
+    const std::vector<Entry>& items() const { return this->c; }
+};
+
+// The n smallest entries of a MinHeap in pop order, O(n log n): a second
+// heap holds the frontier of array slots whose parents have been taken.
+template <class Entry>
+void peekHeap(const MinHeap<Entry>& heap, std::size_t n, std::vector<ProcessHandle>& out)
+{
+    const std::vector<Entry>& a = heap.items();
+    auto later = [&](std::size_t x, std::size_t y) { return a[x] > a[y]; };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> frontier(later);
+    if (!a.empty()) frontier.push(0);
+    while (!frontier.empty() && out.size() < n) {
+        const std::size_t i = frontier.top();
+        frontier.pop();
+        out.push_back(a[i].h);
+        if (2 * i + 1 < a.size()) frontier.push(2 * i + 1);
+        if (2 * i + 2 < a.size()) frontier.push(2 * i + 2);
+    }
+}
+
+// Pops the first entry, in heap order, whose handle `ok` accepts. The ones
+// passed over go back unchanged, key and tie-break alike, so they keep their
+// place; `passed` is the caller's scratch.
+template <class Entry, class Ok>
+bool popHeapIf(MinHeap<Entry>& heap, std::vector<Entry>& passed, Ok&& ok, ProcessHandle& out)
+{
+    passed.clear();
+    bool found = false;
+    while (!heap.empty()) {
+        const Entry e = heap.top();
+        heap.pop();
+        if (ok(e.h)) { out = e.h; found = true; break; }
+        passed.push_back(e);
+    }
+    for (const Entry& e : passed) heap.push(e);
+    return found;
+}
+
+// One FIFO per core; an idle core steals the oldest entry from the next
+// non-empty queue in core order, so the pick depends on nothing but the
+// queues' contents.
+class FifoQueues final : public ReadyQueue {
+public:
+    FifoQueues(ProcessRegistry& registry, int queues);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+
+private:
+    ProcessRegistry& registry;
+
+    std::mutex mx;
+    std::vector<std::deque<ProcessHandle>> queues;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "Rng.h"
+#include <atomic>
+#include <random>
+
+namespace {
+    std::atomic<uint64_t> master{0};
+    std::atomic<uint64_t> nextUnbound{1ull << 48};     // streams for unbound threads
+
+    struct ThreadStream {
+        bool       bound{false};
+        uint64_t   id{0};
+        uint64_t   epoch{0};        // master seed the stream was derived from
+        Xoshiro256 gen;
+    };
+    thread_local ThreadStream local;
+
+    uint64_t randomSeed()
+    {
+        std::random_device rd;
+        uint64_t seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+        return seed ? seed : 1;
+    }
+}
+
+void Rng::setMasterSeed(uint64_t seed)
+{
+    master.store(seed ? seed : randomSeed(), std::memory_order_release);
+}
+
+uint64_t Rng::masterSeed()
+{
+    uint64_t m = master.load(std::memory_order_acquire);
+    if (m) return m;
+
+    // Nobody configured one: the first caller picks it for everyone.
+    master.compare_exchange_strong(m, randomSeed(), std::memory_order_acq_rel);
+    return master.load(std::memory_order_acquire);
+}
+
+uint64_t Rng::derive(uint64_t streamId)
+{
+    uint64_t state = masterSeed() ^ (streamId * 0xD1B54A32D192ED03ull);
+    return splitmix64(state);
+}
+
+void Rng::bindThread(uint64_t streamId)
+{
+    local.bound = true;
+    local.id    = streamId;
+    local.epoch = masterSeed();
+    local.gen.reseed(derive(streamId));
+}
+
+Xoshiro256& Rng::thread()
+{
+    if (!local.bound) {
+        local.bound = true;
+        local.id    = nextUnbound.fetch_add(1, std::memory_order_relaxed);
+    }
+    const uint64_t m = masterSeed();
+    if (local.epoch != m) {
+        local.epoch = m;
+        local.gen.reseed(derive(local.id));
+    }
+    return local.gen;
+}
@@ -0,0 +1,89 @@
+/* ---------- Rng.h ---------- */
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// SplitMix64 step: advances state and returns a well-mixed 64-bit value.
+inline uint64_t splitmix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/*
+ * xoshiro256** generator. Small, fast, and the same sequence on every
+ * platform (std::uniform_int_distribution is not), so seeded runs replay
+ * exactly. Satisfies UniformRandomBitGenerator.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed)
+    {
+        for (auto& w : s) w = splitmix64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()()
+    {
+        const uint64_t out = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t   = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3]  = rotl(s[3], 45);
+        return out;
+    }
+
+    // Uniform in [floor, ceiling], without modulo bias.
+    int between(int floor, int ceiling)
+    {
+        if (ceiling <= floor) return floor;
+        const uint64_t span  = static_cast<uint64_t>(static_cast<int64_t>(ceiling) - floor) + 1;
+        const uint64_t limit = UINT64_MAX - UINT64_MAX % span;
+        uint64_t x;
+        do { x = (*this)(); } while (x >= limit);
+        return static_cast<int>(floor + static_cast<int64_t>(x % span));
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/*
+ * Process-wide source of seeds. Every stream is derived from one master
+ * seed (the `seed` key in Config.txt), so a run with the same seed and the
+ * same inputs draws the same numbers. Each thread draws from its own
+ * stream and never locks; long-lived threads bind a fixed stream ID so the
+ * mapping does not depend on which thread starts first.
+ */
+namespace Rng {
+    enum : uint64_t {
+        kMainStream    = 0,         // console commands
+        kClockStream   = 1,         // batch process generation
+        kCoreStream    = 16,        // + core ID
+        kProgramStream = 1ull << 32 // + process ID: program generator seeds
+    };
+
+    void     setMasterSeed(uint64_t seed);     // 0 picks one from random_device
+    uint64_t masterSeed();
+    uint64_t derive(uint64_t streamId);        // seed of stream streamId
+
+    void        bindThread(uint64_t streamId); // calling thread uses this stream
+    Xoshiro256& thread();                      // calling thread's stream
+    inline int  between(int floor, int ceiling) { return thread().between(floor, ceiling); }
+}
+
+#endif
@@ -0,0 +1,27 @@
+#include "SchedPolicy.h"
+
+SchedKind parseSchedKind(const std::string& name)
+{
+    if (name == "fcfs" || name == "FCFS")         return SchedKind::FCFS;
+    if (name == "priority" || name == "prio")     return SchedKind::PRIORITY;
+    if (name == "cfs" || name == "CFS")           return SchedKind::CFS;
+    if (name == "mlfq" || name == "MLFQ")         return SchedKind::MLFQ;
+    if (name == "sjf" || name == "SJF")           return SchedKind::SJF;
+    if (name == "srtf" || name == "SRTF")         return SchedKind::SRTF;
+    if (name == "edf" || name == "EDF")           return SchedKind::EDF;
+    return SchedKind::RR;
+}
+
+const char* schedKindName(SchedKind kind)
+{
+    switch (kind) {
+        case SchedKind::FCFS:     return "fcfs";
+        case SchedKind::PRIORITY: return "priority";
+        case SchedKind::CFS:      return "cfs";
+        case SchedKind::MLFQ:     return "mlfq";
+        case SchedKind::SJF:      return "sjf";
+        case SchedKind::SRTF:     return "srtf";
+        case SchedKind::EDF:      return "edf";
+        default:                  return "rr";
+    }
+}
@@ -0,0 +1,186 @@
+/* ---------- SchedPolicy.h ---------- */
+#ifndef SCHEDPOLICY_H
+#define SCHEDPOLICY_H
+
+#include <string>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include "Config.h"
+#include "ProcessInfo.h"
+#include "ReadyQueue.h"
+#include "PriorityQueues.h"
+#include "CfsQueue.h"
+#include "MlfqQueues.h"
+#include "ShortestFirstQueue.h"
+#include "EdfQueue.h"
+
+class ProcessRegistry;
+
+enum class SchedKind { FCFS, RR, PRIORITY, CFS, MLFQ, SJF, SRTF, EDF };
+
+// "fcfs", "rr", "priority", "cfs", "mlfq", "sjf", "srtf", "edf"; default rr
+SchedKind parseSchedKind(const std::string& name);
+const char* schedKindName(SchedKind kind);
+
+/*
+ * Compile-time scheduling policies.
+ * Scheduler::clockLoop<Policy> and coreLoop<Policy> are instantiated once
+ * per policy, so neither the clock's dispatch nor a core's tick carries
+ * runtime policy checks; the policy itself is picked once, from Config.txt,
+ * when the threads start. Only the clock thread pops the queues.
+ *
+ *   Queue                       concrete ReadyQueue the clock's dispatch calls directly
+ *   kPreemptive                 whether a slice can end before the program does
+ *   makeQueue(cfg, reg)         the ready set, built once by the scheduler
+ *   slice(cfg, p, runnable)     ticks p may run on this dispatch
+ *   charge(cfg, p, ran, full)   bookkeeping as p leaves the core
+ */
+struct FcfsPolicy {
+    using Queue = FifoQueues;
+    static constexpr bool kPreemptive = false;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config& cfg, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new FifoQueues(reg, cfg.numCpu));
+    }
+    static int  slice(const Config&, const ProcessInfo&, int) { return std::numeric_limits<int>::max(); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+struct RoundRobinPolicy {
+    using Queue = FifoQueues;
+    static constexpr bool kPreemptive = true;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config& cfg, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new FifoQueues(reg, cfg.numCpu));
+    }
+    static int  slice(const Config& cfg, const ProcessInfo&, int) { return std::max(1, cfg.quantumCycles); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+// Most urgent priority level first, round-robin within a level, with aging.
+struct PriorityPolicy {
+    using Queue = PriorityQueues;
+    static constexpr bool kPreemptive = true;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config& cfg, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(
+            new PriorityQueues(reg, cfg.agingCycles > 0 ? cfg.agingCycles : 100));
+    }
+    static int  slice(const Config& cfg, const ProcessInfo&, int) { return std::max(1, cfg.quantumCycles); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+/*
+ * Fair share: least vruntime first. The target latency is split among the
+ * runnable processes of each core, so slices shrink under load down to the
+ * minimum granularity; a process is charged the ticks it actually ran, so
+ * one that sleeps early keeps its place near the front.
+ */
+struct CfsPolicy {
+    using Queue = CfsQueue;
+    static constexpr bool kPreemptive = true;
+
+    static int latency(const Config& cfg)     { return cfg.cfsLatency > 0 ? cfg.cfsLatency : 24; }
+    static int granularity(const Config& cfg) { return cfg.cfsMinGranularity > 0 ? cfg.cfsMinGranularity : 3; }
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config& cfg, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new CfsQueue(reg, latency(cfg) / 2));
+    }
+    static int slice(const Config& cfg, const ProcessInfo&, int runnable) {
+        const int perCore = std::max(1, runnable / std::max(1, cfg.numCpu));
+        return std::max(granularity(cfg), latency(cfg) / perCore);
+    }
+    static void charge(const Config&, ProcessInfo& p, int ran, bool) {
+        p.vruntime += static_cast<uint64_t>(std::max(0, ran));
+    }
+};
+
+/*
+ * Multi-level feedback queue. Everyone starts on the top level; the quantum
+ * doubles per level down. Using a whole slice demotes a process one level,
+ * giving it up through SLEEP promotes it one, and MlfqQueues periodically
+ * puts everyone back on top so demoted batch work cannot starve.
+ */
+struct MlfqPolicy {
+    using Queue = MlfqQueues;
+    static constexpr bool kPreemptive = true;
+
+    static int levels(const Config& cfg) {
+        return std::min(cfg.mlfqLevels > 0 ? cfg.mlfqLevels : 3, kMlfqMaxLevels);
+    }
+    static int quantum(const Config& cfg, int level) {
+        const long long q = static_cast<long long>(std::max(1, cfg.quantumCycles)) << level;
+        return static_cast<int>(std::min<long long>(q, std::numeric_limits<int>::max()));
+    }
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config& cfg, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new MlfqQueues(
+            reg, levels(cfg), cfg.mlfqBoostCycles > 0 ? cfg.mlfqBoostCycles : 1000));
+    }
+    static int slice(const Config& cfg, const ProcessInfo& p, int) {
+        return quantum(cfg, std::min(std::max(p.mlfqLevel, 0), levels(cfg) - 1));
+    }
+    static void charge(const Config& cfg, ProcessInfo& p, int ran, bool exhausted) {
+        if (exhausted && ran >= slice(cfg, p, 0))
+            p.mlfqLevel = std::min(p.mlfqLevel + 1, levels(cfg) - 1);
+        else if (!exhausted)
+            p.mlfqLevel = std::max(p.mlfqLevel - 1, 0);
+    }
+};
+
+// Shortest job first: the fewest remaining instructions runs to completion.
+struct SjfPolicy {
+    using Queue = ShortestFirstQueue;
+    static constexpr bool kPreemptive = false;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config&, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new ShortestFirstQueue(reg));
+    }
+    static int  slice(const Config&, const ProcessInfo&, int) { return std::numeric_limits<int>::max(); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+// Shortest remaining time first, re-decided at every quantum boundary.
+struct SrtfPolicy {
+    using Queue = ShortestFirstQueue;
+    static constexpr bool kPreemptive = true;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config&, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new ShortestFirstQueue(reg));
+    }
+    static int  slice(const Config& cfg, const ProcessInfo&, int) { return std::max(1, cfg.quantumCycles); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+// Earliest deadline first, re-decided at every quantum boundary.
+struct EdfPolicy {
+    using Queue = EdfQueue;
+    static constexpr bool kPreemptive = true;
+
+    static std::unique_ptr<ReadyQueue> makeQueue(const Config&, ProcessRegistry& reg) {
+        return std::unique_ptr<ReadyQueue>(new EdfQueue(reg));
+    }
+    static int  slice(const Config& cfg, const ProcessInfo&, int) { return std::max(1, cfg.quantumCycles); }
+    static void charge(const Config&, ProcessInfo&, int, bool) {}
+};
+
+template <class Policy> struct PolicyTag { using type = Policy; };
+
+// Calls fn(PolicyTag<P>{}) with the policy type named by kind.
+template <class Fn>
+void withPolicy(SchedKind kind, Fn&& fn)
+{
+    switch (kind) {
+        case SchedKind::FCFS:     fn(PolicyTag<FcfsPolicy>{});       break;
+        case SchedKind::PRIORITY: fn(PolicyTag<PriorityPolicy>{});   break;
+        case SchedKind::CFS:      fn(PolicyTag<CfsPolicy>{});        break;
+        case SchedKind::MLFQ:     fn(PolicyTag<MlfqPolicy>{});       break;
+        case SchedKind::SJF:      fn(PolicyTag<SjfPolicy>{});        break;
+        case SchedKind::SRTF:     fn(PolicyTag<SrtfPolicy>{});       break;
+        case SchedKind::EDF:      fn(PolicyTag<EdfPolicy>{});        break;
+        default:                  fn(PolicyTag<RoundRobinPolicy>{}); break;
+    }
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "Scheduler.h"
 #include "Commands.h"
+#include "Rng.h"
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -9,32 +10,23 @@
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <cstdio>
 extern std::atomic<int> g_attachedPid;
 int curQuantumCycle = 1;
 
 namespace {
     std::mutex g_coutMx;
 
-    inline std::string stripQuotes(const std::string& s) {
-        return (s.size() >= 2 && s.front() == '"' && s.back() == '"')
-             ? s.substr(1, s.size() - 2) : s;
-    }
-    inline std::string varVal(const ProcessInfo& p, const std::string& n) {
-        auto it = p.vars.find(n);
-        return (it != p.vars.end()) ? std::to_string(it->second) : "0";
-    }
-}
+    // The program pool builds for the next kPrefetchAhead processes in the
+    // policy's ready order, refreshed every kPrefetchEvery cycles.
+    constexpr std::size_t kPrefetchAhead = 64;
+    constexpr uint64_t    kPrefetchEvery = 4;
 
-static uint16_t Stoi16(const std::string& s, const std::string& ctx = "<unknown>") {
-    try {
-        long v = std::stol(s);
-        if (v < 0) v = 0;
-        if (v > 65535) v = 65535;
-        return static_cast<uint16_t>(v);
-    } catch (const std::exception& e) {
-        std::cerr << " Debug: Stoi error in " << ctx
-                  << " : \"" << s << "\" – " << e.what() << '\n';
-        return 0;
+    inline uint16_t operandB(const ByteInstr& in, const uint16_t* regs) {
+        return (in.flags & ARG_B_REG) ? regs[in.b] : in.b;
+    }
+    inline uint16_t operandC(const ByteInstr& in, const uint16_t* regs) {
+        return (in.flags & ARG_C_REG) ? regs[in.c] : in.c;
     }
 }
 
@@ -42,29 +34,78 @@ std::string Scheduler::utilisationString() const
 {
     std::ostringstream os;
     double pct = (coresInUse.load() * 100.0) / config.numCpu;
+    const uint64_t cycles = cycle.load();
+    double avg = cycles ? (busyCoreCycles.load() * 100.0) / (cycles * config.numCpu)
+                        : 0.0;
+
+    uint64_t finished = 0;
+    const double turnaround = archive.meanTurnaround(finished);
 
     os << "CPU utilisation : "
        << std::fixed << std::setprecision(1) << pct << "%\n"
        << "Cores used      : " << coresInUse        << '\n'
-       << "Cores available : " << (config.numCpu - coresInUse) << "\n\n";
+       << "Cores available : " << (config.numCpu - coresInUse) << '\n'
+       << "Avg utilisation : " << avg << "% over " << cycles << " cycles\n"
+       << "Scheduler       : " << schedKindName(kind) << '\n'
+       << "Mean turnaround : " << turnaround << " cycles over " << finished << " finished\n";
+    if (kind == SchedKind::EDF || deadlinesMet || deadlinesMissed)
+        os << "Deadlines       : " << deadlinesMet << " met, " << deadlinesMissed << " missed, "
+           << deadlinesRejected << " rejected\n";
+    os << '\n';
 
     return os.str();
 }
 
-Scheduler::Scheduler(const Config& config)
-    : config(config), running(true), schedulerType(config.scheduler), quantum(config.quantumCycles) {
+// Wall-clock pacing for one emulated tick; turbo mode runs unpaced.
+void Scheduler::tickDelay() const
+{
+    if (!config.turbo && config.delaysPerExec)
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(config.delaysPerExec)
+        );
+}
+
+Scheduler::Scheduler(const Config& config, std::shared_ptr<ProcessRegistry> registry)
+    : config(config), running(true), kind(parseSchedKind(config.scheduler)),
+      numQueues(std::max(1, config.numCpu)),
+      registry(std::move(registry)),
+      logs(config.numCpu),
+      memory(config.maxOverallMem, config.memPerFrame, parseFitPolicy(config.memAlloc)),
+      smallestFitFirst(config.memAdmission == "smallest-fit" || config.memAdmission == "smallest"),
+      archive(config.finishedCap > 0 ? config.finishedCap : 10000, "finished-archive.txt"),
+      programs(std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2)), 256) {
+    withPolicy(kind, [&](auto tag) {
+        using Policy = typename decltype(tag)::type;
+        ready = Policy::makeQueue(config, *this->registry);
+    });
+
+    slots.resize(static_cast<std::size_t>(std::max(0, config.numCpu)));
     for (int i = 0; i < config.numCpu; ++i) {
         coreThreads.emplace_back(&Scheduler::coreFunction, this, i + 1);  // Start core IDs from 1
     }
+    clockThread = std::thread(&Scheduler::clockFunction, this);
 }
 
 Scheduler::~Scheduler() {
     stop();
+    if (clockThread.joinable()) clockThread.join();
     for (auto& thread : coreThreads) {
         if (thread.joinable()) {
             thread.join();
         }
     }
+    // Both sides are joined, so the slots are ours. Retire what the cores
+    // handed back on the way out, and what the clock dispatched that no core
+    // picked up, so a process that finished in the last cycle still reaches
+    // the archive and the rest go back to READY.
+    for (int core = 1; core <= config.numCpu; ++core) {
+        CoreSlot& slot = slots[core - 1];
+        if (slot.proc == kNoProcess) continue;
+        slot.leaving = true;
+        retire(core);
+    }
+    logs.stop();
+    archive.close();
 }
 
 void Scheduler::start() {
@@ -73,114 +114,270 @@ void Scheduler::start() {
 
 void Scheduler::stop() {
     running = false;
+    {
+        std::lock_guard<std::mutex> lk(idleMutex);
+    }
     cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lk(clockMutex);
+    }
+    clockCv.notify_all();
+    doneCv.notify_all();
 }
 
-void Scheduler::addProcess(ProcessInfo&& proc)
+// Taking idleMutex orders this wake-up after the clock's idle check.
+void Scheduler::wakeClock()
 {
-    std::lock_guard<std::mutex> lk(queueMutex);
-    processQueue.emplace_back(std::move(proc));   // move into queue
-    cv.notify_one();
+    {
+        std::lock_guard<std::mutex> lk(idleMutex);
+    }
+    cv.notify_all();
+}
+
+void Scheduler::pushReady(int queueIdx, ProcessHandle proc)
+{
+    ready->push(queueIdx, proc);
+    ++readyCount;
+    wakeClock();
 }
 
-void Scheduler::addProcess(const ProcessInfo& proc)
+void Scheduler::setState(ProcessHandle h, ProcState state)
 {
-    addProcess(ProcessInfo(proc));
+    StatusCell& cell = registry->status(h);
+    ProcessStatus st = cell.read();
+    st.state = state;
+    cell.publish(st);
 }
 
-ProcessInfo& Scheduler::getProcess(const std::string& name) {
-    std::lock_guard<std::mutex> lock(queueMutex);
+void Scheduler::parkSleeping(ProcessHandle proc)
+{
+    std::lock_guard<std::mutex> lk(sleepMutex);
+    const uint64_t due = cycle.load() + static_cast<uint64_t>((*registry)[proc].sleepTicks);
+    sleepers.schedule(due, std::move(proc));
+    ++sleepingCount;
+}
 
-    // Check running processes
-    for (auto& process : runningProcesses) {
-        if (process.processName == name) {
-            return process;
-        }
+// Called by the clock between cycles; woken processes rejoin their last core's queue.
+// An empty wheel is kept in step with the clock, so the next SLEEP is timed
+// from now rather than from whenever the wheel last had sleepers.
+void Scheduler::wakeSleepers(uint64_t now)
+{
+    {
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        if (sleepers.empty()) { sleepers.reset(now); return; }
+        woken.clear();
+        sleepers.advance(now, [&](ProcessHandle&& h) { woken.push_back(h); });
     }
 
-    // Check waiting queue (processQueue)
-    for (auto& process : processQueue) {
-        if (process.processName == name) {
-            return process;
-        }
+    for (ProcessHandle h : woken) {
+        ProcessInfo& p = (*registry)[h];
+        p.sleepTicks = 0;
+        const int idx = homeQueue(p);
+        --sleepingCount;
+        setState(h, ProcState::READY);
+        pushReady(idx, h);
     }
+}
+
+// EDF admission test, O(1): every core runs one instruction per cycle, so
+// the work already promised plus this process must fit in `ticks` cycles
+// across all cores. Optimistic: it counts instructions only, not the cycles
+// a process spends in SLEEP or waiting for memory, so an admitted process
+// can still miss its deadline.
+bool Scheduler::fitsDeadline(int64_t promised, uint32_t work, uint32_t ticks) const
+{
+    const int64_t cores = std::max(1, config.numCpu);
+    return (promised + work + cores - 1) / cores <= static_cast<int64_t>(ticks);
+}
 
-    throw std::runtime_error("Process not found: " + name);
+// Queue for p: its last core's, as long as p may still run there, else the
+// first core its affinity allows. Per-core queues keep it there unless
+// another core runs dry and steals it.
+int Scheduler::homeQueue(const ProcessInfo& p) const
+{
+    const int n = numQueues;
+    if (p.assignedCore > 0 && p.allowedOn(p.assignedCore))
+        return (p.assignedCore - 1) % n;
+    for (int core = 1; core <= n && core <= 64; ++core)
+        if (p.allowedOn(core)) return core - 1;
+    return 0;
 }
 
-ProcessInfo Scheduler::snapshotProcess(const std::string& name)
+// Registers a new process; returns kNoProcess if its name or PID is taken,
+// or if edf cannot finish it by its deadline, and says which in `why`.
+ProcessHandle Scheduler::admit(ProcessInfo&& proc, AddResult& why)
 {
-    std::lock_guard<std::mutex> lk(queueMutex);
+    proc.arrivalCycle = cycle.load();
+    if (proc.relDeadline) {
+        const uint32_t work = static_cast<uint32_t>(std::max(1, proc.totalLine));
+        if (kind == SchedKind::EDF) {
+            int64_t promised = deadlineWork.load();
+            do {
+                if (!fitsDeadline(promised, work, proc.relDeadline)) {
+                    ++deadlinesRejected;
+                    why = AddResult::DEADLINE_REJECTED;
+                    return kNoProcess;
+                }
+            } while (!deadlineWork.compare_exchange_weak(promised, promised + work));
+        }
+        else {
+            deadlineWork += work;
+        }
+        proc.deadline     = proc.arrivalCycle + proc.relDeadline;
+        proc.reservedWork = work;
+    }
 
-    for (auto& p : runningProcesses) if (p.processName == name) return p;
-    for (auto& p : processQueue)    if (p.processName == name) return p;
-    for (auto& e : finishedProcesses) if (e.first.processName == name) return e.first;
+    const uint32_t reserved = proc.reservedWork;
+    const ProcessHandle h = registry->insert(std::move(proc));
+    if (h == kNoProcess) {
+        deadlineWork -= reserved;
+        why = AddResult::NAME_TAKEN;
+        return kNoProcess;
+    }
+    why = AddResult::ADDED;
 
-    throw std::runtime_error("Process not found: " + name);
+    // Seeded processes register their log when the program is built.
+    const ProcessInfo& pcb = (*registry)[h];
+    if (pcb.code)
+        logs.open(pcb.processID, pcb.processName, pcb.code);
+    return h;
 }
 
-std::vector<std::pair<ProcessInfo, int>> Scheduler::getFinishedProcesses() {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    return finishedProcesses;
-}
+AddResult Scheduler::addProcess(ProcessInfo&& proc)
+{
+    AddResult why;
+    const ProcessHandle h = admit(std::move(proc), why);
+    if (h == kNoProcess) return why;
 
-std::vector<ProcessInfo> Scheduler::getRunningProcesses() {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    return runningProcesses;
+    const ProcessInfo& pcb = (*registry)[h];
+    pushReady(pcb.affinity ? homeQueue(pcb) : static_cast<int>(nextQueue++ % numQueues), h);
+    return AddResult::ADDED;
 }
 
-std::vector<ProcessInfo> Scheduler::getWaitingProcesses() {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    return std::vector<ProcessInfo>(processQueue.begin(), processQueue.end());
-}
+// Deals the batch round-robin over the run queues, handing the queue the
+// whole batch at once, and wakes the clock once for all of them.
+std::size_t Scheduler::addProcesses(std::vector<ProcessInfo>&& batch)
+{
+    const int n = numQueues;
+    std::vector<std::vector<ProcessHandle>> dealt(n);
+    const unsigned first = nextQueue.fetch_add(static_cast<unsigned>(batch.size()));
+
+    std::size_t added = 0;
+    AddResult why;
+    for (auto& proc : batch) {
+        const ProcessHandle h = admit(std::move(proc), why);
+        if (h == kNoProcess) continue;
+        const ProcessInfo& pcb = (*registry)[h];
+        dealt[pcb.affinity ? homeQueue(pcb) : (first + added) % n].push_back(h);
+        ++added;
+    }
+    batch.clear();
+    if (!added) return 0;
+
+    ready->pushMany(dealt);
+    readyCount += static_cast<int>(added);
 
-bool Scheduler::allocateMemory(ProcessInfo& proc) {
-    const int frameSize = config.memPerFrame;
-    const int blockReq = config.memPerProc;
-    // Round up required bytes to nearest frame
-    int reqFrames = (blockReq + frameSize - 1) / frameSize;
-    int reqBytes  = reqFrames * frameSize;
+    // Only the clock thread waits on cv.
+    {
+        std::lock_guard<std::mutex> lk(idleMutex);
+    }
+    cv.notify_one();
+    return added;
+}
 
-    int lastEnd = 0;
-    for (auto it = memoryBlocks.begin(); it != memoryBlocks.end(); ++it) {
-        int alignedEnd = ((lastEnd + frameSize - 1) / frameSize) * frameSize;
-        int gap = it->start - alignedEnd;
-        if (gap >= reqBytes) {
-            memoryBlocks.insert(it,
-                MemoryBlock{ alignedEnd,
-                             alignedEnd + reqBytes,
-                             proc.processName });
+// Live processes come from their status cell, finished ones from the archive.
+bool Scheduler::processStatus(const std::string& name, ProcessStatus& out) const
+{
+    {
+        auto guard = registry->readGuard();
+        const ProcessHandle h = registry->findByName(name);
+        if (h != kNoProcess) {
+            out = registry->status(h).read();
             return true;
         }
-        lastEnd = it->end;
     }
 
-    int alignedEnd = ((lastEnd + frameSize - 1) / frameSize) * frameSize;
-    if (config.maxOverallMem - alignedEnd >= reqBytes) {
-        memoryBlocks.push_back(
-            MemoryBlock{ alignedEnd,
-                         alignedEnd + reqBytes,
-                         proc.processName });
-        return true;
+    FinishedSummary s;
+    if (!archive.find(name, s))
+        return false;
+
+    ProcessStatus& st = out;
+    st = ProcessStatus{};
+    st.pid           = s.pid;
+    st.state         = ProcState::FINISHED;
+    st.core          = s.core;
+    st.migrations    = s.migrations;
+    st.executed      = s.total;
+    st.total         = s.total;
+    st.finishedCycle = s.finishedCycle;
+    return true;
+}
+
+bool Scheduler::knows(const std::string& name) const
+{
+    return registry->contains(name) || archive.contains(name);
+}
+
+// Reads every live process's published status; takes no lock.
+std::vector<ProcessStatus> Scheduler::statusList() const
+{
+    std::vector<ProcessStatus> out;
+    out.reserve(registry->size());
+    registry->forEach([&](ProcessHandle h) {
+        const ProcessStatus st = registry->status(h).read();
+        if (st.state != ProcState::FREE) out.push_back(st);
+    });
+    return out;
+}
+
+// First dispatch: fetch the program built from the seed and open its log.
+void Scheduler::materialize(ProcessInfo& proc)
+{
+    proc.code      = programs.take(proc.processID, proc.seed, proc.programSize);
+    proc.totalLine = static_cast<int>(proc.code->execCount);
+    logs.open(proc.processID, proc.processName, proc.code);
+}
+
+// Clock thread: points the program pool at the unbuilt programs next in
+// line. Queued processes are on no core, so their PCBs are safe to read.
+void Scheduler::prefetchUpcoming()
+{
+    upcoming.clear();
+    ready->peek(kPrefetchAhead, upcoming);
+    wanted.clear();
+    for (ProcessHandle h : upcoming) {
+        const ProcessInfo& p = (*registry)[h];
+        if (!p.code && p.programSize > 0)
+            wanted.push_back(ProgramRequest{ p.processID, p.seed, p.programSize });
     }
+    programs.want(wanted);
+}
 
-    return false;
+// Clock thread.
+void Scheduler::parkMemoryWait(ProcessHandle proc)
+{
+    const int key = smallestFitFirst ? config.memPerProc : 0;
+    setState(proc, ProcState::MEMWAIT);
+    memWaiters.emplace(std::make_pair(key, memWaitSeq++), proc);
 }
 
-void Scheduler::deallocateMemory(const std::string& pid) {
-    memoryBlocks.erase(
-        std::remove_if(
-            memoryBlocks.begin(),
-            memoryBlocks.end(),
-            [&](auto& b){ return b.pid == pid; }
-        ),
-        memoryBlocks.end()
-    );
+// Clock thread. Admits waiters in order while the head fits; the
+// head is never bypassed, so a large request cannot starve behind small ones.
+void Scheduler::admitMemoryWaiters(std::vector<ProcessHandle>& admitted)
+{
+    while (!memWaiters.empty()) {
+        auto it = memWaiters.begin();
+        const ProcessInfo& p = (*registry)[it->second];
+        if (!memory.canFit(config.memPerProc)
+         || !memory.allocate(p.processID, p.processName, config.memPerProc))
+            break;
+        setState(it->second, ProcState::READY);
+        admitted.push_back(it->second);
+        memWaiters.erase(it);
+    }
 }
 
 void Scheduler::writeMemorySnapshot() {
-    std::lock_guard<std::mutex> lk(queueMutex);
-
     std::ostringstream fn;
     fn << "memory_stamp_"
        << std::setw(2) << std::setfill('0') << curQuantumCycle
@@ -191,31 +388,19 @@ void Scheduler::writeMemorySnapshot() {
 
     file << "Timestamp: (" << Commands::getCurrentTimestamp() << ")\n";
     file << "Number of processes in memory: "
-         << memoryBlocks.size() << "\n";
-
-    // Compute total external fragmentation (bytes)
-    int totalFrag = 0;
-    int lastEnd   = 0;
-    std::vector<MemoryBlock> asc = memoryBlocks;
-    std::sort(asc.begin(), asc.end(),
-              [](auto const &a, auto const &b){ return a.start < b.start; });
-    for (auto const &blk : asc) {
-        if (blk.start > lastEnd)
-            totalFrag += blk.start - lastEnd;
-        lastEnd = blk.end;
-    }
-    if (lastEnd < config.maxOverallMem)
-        totalFrag += config.maxOverallMem - lastEnd;
+         << memory.residentCount() << "\n";
+
+    // Total external fragmentation (bytes): everything not held by a process
+    int totalFrag = config.maxOverallMem - (memory.totalBytes() - memory.freeBytes());
 
     file << "Total external fragmentation in KB: "
          << (totalFrag / 1024) << "\n\n";
 
     file << "----end---- = " << config.maxOverallMem << "\n\n";
 
-    std::vector<MemoryBlock> desc = memoryBlocks;
-    std::sort(desc.begin(), desc.end(),
-              [](auto const &a, auto const &b){ return a.start > b.start; });
-    for (auto const &blk : desc) {
+    std::vector<MemoryBlock> blocks = memory.blocks();
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+        const MemoryBlock& blk = *it;
         file << blk.end << "\n"
              << blk.pid << "\n"
              << blk.start << "\n\n";
@@ -227,225 +412,391 @@ void Scheduler::writeMemorySnapshot() {
     ++curQuantumCycle;
 }
 
+// Picks the policy once; everything below runs as coreLoop<Policy>.
 void Scheduler::coreFunction(int nCoreId)
 {
-    auto nowStamp = []() -> std::string {
-        using namespace std::chrono;
-        auto tp = system_clock::now();
-        auto ms = duration_cast<milliseconds>(tp.time_since_epoch()) % 1000;
-        std::time_t tt = system_clock::to_time_t(tp);
-        std::tm tm;
-    #ifdef _WIN32
-        localtime_s(&tm, &tt);
-    #else
-        localtime_r(&tt, &tm);
-    #endif
-        std::ostringstream os;
-        os << std::put_time(&tm, "%H:%M:%S") << '.'
-           << std::setw(3) << std::setfill('0') << ms.count();
-        return os.str();
-    };
+    Rng::bindThread(Rng::kCoreStream + nCoreId);
+    withPolicy(kind, [&](auto tag) {
+        this->coreLoop<typename decltype(tag)::type>(nCoreId);
+    });
+}
 
-    auto log = [&](ProcessInfo& p, const std::string& what, int indent) {
-        p.outBuf.emplace_back(
-            nowStamp() + " | Core:" + std::to_string(nCoreId)
-          + " [" + std::to_string(p.executedLines) + "] "
-          + std::string(indent * 4, ' ')
-          + what
-        );
-    };
+template <class Policy>
+void Scheduler::coreLoop(int nCoreId)
+{
+    const int queueIdx = nCoreId - 1;
+    CoreSlot& slot     = slots[queueIdx];
+    int       slice    = 0;             // this dispatch's, from the policy
+
+    // The PCB is run in place. Progress counters stay in these locals while
+    // the process is on the core and are written back when it leaves.
+    ProcessHandle cur  = kNoProcess;
+    ProcessInfo*  proc = nullptr;
+    uint32_t pc       = 0;
+    int      executed = 0;
+    int      total    = 0;
+    ProcessStatus st;                           // proc's published status
+    int      used = 0;
+    bool     slept = false;                     // gave the core up through SLEEP
+    uint64_t seen = 0;
+
+    // Runs one tick of proc; returns false once its slice is over.
+    auto runTick = [&]() -> bool {
+        if (!proc->code) return false;
+
+        const Program& code = *proc->code;
+        const auto&    ops  = code.ops;
+        const uint32_t size = static_cast<uint32_t>(ops.size());
+        uint16_t*      regs = proc->regs.data();
+        auto&          loopStack = proc->loopStack;
+
+        if (pc >= size)
+            return false;
+
+        const ByteInstr& in = ops[pc];
+        bool yield = false;
+
+        switch (in.op)
+        {
+            case ByteOp::DECLARE:
+                regs[in.dst] = in.b;
+                break;
 
-    while (running)
-    {
-        ProcessInfo proc(-1, "", 0, "");
+            case ByteOp::LOOP_INIT:
+                loopStack.push_back(LoopFrame{ pc + 1, in.b });
+                break;
 
-        {
-            std::unique_lock<std::mutex> lk(queueMutex);
-            cv.wait(lk, [&]{ return !processQueue.empty() || !running; });
-            if (!running && processQueue.empty()) return;
-
-            proc = std::move(processQueue.front());
-            processQueue.pop_front();
-
-            bool alreadyInMem = std::any_of(
-                memoryBlocks.begin(), memoryBlocks.end(),
-                [&](auto const &blk){ return blk.pid == proc.processName; }
-            );
-            if (!alreadyInMem) {
-                if (!allocateMemory(proc)) {
-                    processQueue.push_back(std::move(proc));
-                    continue;
-                }
+            case ByteOp::ADD: {
+                uint32_t r = uint32_t(operandB(in, regs)) + operandC(in, regs);
+                regs[in.dst] = static_cast<uint16_t>(std::min(r, 65535u));
+                break;
             }
 
-            proc.assignedCore = nCoreId;
-            runningProcesses.push_back(proc);
-            ++coresInUse;
+            case ByteOp::SUBTRACT: {
+                uint16_t v2 = operandB(in, regs), v3 = operandC(in, regs);
+                regs[in.dst] = (v2 >= v3) ? uint16_t(v2 - v3) : uint16_t(0);
+                break;
+            }
+
+            // SLEEP t keeps the process off-core for t ticks, this one
+            // included, as before; the rest it spends parked.
+            case ByteOp::SLEEP:
+                proc->sleepTicks = in.b > 0 ? in.b - 1 : 0;
+                slept = true;
+                yield = true;
+                break;
+
+            default: break;
+        }
+
+        if (in.op != ByteOp::NOP)
+            logs.record(queueIdx, proc->processID, proc->logSeq,
+                        static_cast<uint32_t>(executed),
+                        static_cast<uint16_t>(nCoreId), in,
+                        (in.flags & ARG_C_REG) ? regs[in.dst] : uint16_t(0));
+
+        ++pc;
+        ++executed;
+        if (executed > total)
+            total = executed;
+        ++used;
+
+        st.executed = static_cast<uint32_t>(executed);
+        st.total    = static_cast<uint32_t>(total);
+        registry->status(cur).publish(st);
+
+        // Loop back-edges cost no tick of their own.
+        while (pc < size && ops[pc].op == ByteOp::LOOP_NEXT && !loopStack.empty()) {
+            LoopFrame& top = loopStack.back();
+            if (--top.remaining > 0) {
+                pc = top.bodyStart;
+            }
+            else {
+                loopStack.pop_back();
+                ++pc;
+            }
         }
 
-        const bool fcfs = (schedulerType == "fcfs" || schedulerType == "FCFS");
-        const int  slice = fcfs
-                          ? std::numeric_limits<int>::max()
-                          : std::max(1, quantum);
-        auto&      loopStack = proc.loopStack;
+        if (yield)
+            return false;
+        return (!Policy::kPreemptive || used < slice) && pc < size;
+    };
 
-        for (int used = 0; used < slice && running; )
-        {
-            if (proc.sleepTicks) {
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(config.delaysPerExec)
-                );
-                --proc.sleepTicks;
-                ++used;
-                if (!proc.sleepTicks) ++proc.currentLine;
-                if (used % config.quantumCycles == 0) writeMemorySnapshot();
-                continue;
+    // Writes the progress back and hands the process to the clock, which
+    // retires it between cycles: finished, sleeping, or back to a ready queue.
+    auto leave = [&]() {
+        const bool finished = (!proc->code || pc >= proc->code->ops.size())
+                           && proc->sleepTicks == 0;
+        if (finished)
+            logs.close(queueIdx, proc->processID, proc->logSeq);
+
+        proc->currentLine   = static_cast<int>(pc);
+        proc->executedLines = executed;
+        proc->totalLine     = total;
+        proc->isFinished    = finished;
+        if (!finished)
+            Policy::charge(config, *proc, used, !slept);
+
+        slot.ran     = used;
+        slot.leaving = true;
+        cur  = kNoProcess;
+        proc = nullptr;
+    };
+
+    while (awaitCycle(seen))
+    {
+        // Picks up what the clock dispatched here before this cycle.
+        if (cur == kNoProcess && slot.proc != kNoProcess && !slot.leaving) {
+            cur      = slot.proc;
+            proc     = &(*registry)[cur];
+            pc       = static_cast<uint32_t>(proc->currentLine);
+            executed = proc->executedLines;
+            total    = proc->totalLine;
+            st       = registry->status(cur).read();
+            if (!proc->code && proc->programSize > 0) {
+                materialize(*proc);
+                total    = proc->totalLine;
+                st.total = static_cast<uint32_t>(total);
+                registry->status(cur).publish(st);
             }
+            if (proc->code && proc->regs.size() < proc->code->numRegs)
+                proc->regs.resize(proc->code->numRegs, 0);
+            used  = 0;
+            slept = false;
+            slice = slot.slice;
+        }
 
-            if (proc.currentLine >= static_cast<int>(proc.prog.size()))
-                break;
+        if (cur != kNoProcess && !runTick())
+            leave();
 
-            Instruction& ins = proc.prog[proc.currentLine];
-            int indent = static_cast<int>(loopStack.size());
-
-            switch (ins.op)
-            {
-                case OpCode::PRINT: {
-                    std::string txt = stripQuotes(ins.arg1);
-                    if (ins.arg2.size()) txt += '+' + ins.arg2
-                                          + ": " + varVal(proc, ins.arg2);
-                    log(proc, "PRINT -> " + txt, indent);
-                    break;
-                }
+        arriveCycle();
+    }
 
-                case OpCode::DECLARE:
-                    proc.vars[ins.arg1] = Stoi16(ins.arg2, ins.arg1);
-                    log(proc, "DECLARE " + ins.arg1 + '=' + ins.arg2, indent);
-                    break;
-
-                case OpCode::ADD:
-                case OpCode::SUBTRACT: {
-                    uint16_t v2 = ins.isArg2Var
-                                ? proc.vars[ins.arg2]
-                                : Stoi16(ins.arg2, ins.arg2);
-                    uint16_t v3 = ins.isArg3Var
-                                ? proc.vars[ins.arg3]
-                                : Stoi16(ins.arg3, ins.arg3);
-                    uint32_t r = (ins.op == OpCode::ADD)
-                                   ? v2 + v3
-                                   : (v2 >= v3 ? v2 - v3 : 0);
-                    proc.vars[ins.arg1] = static_cast<uint16_t>(std::min(r, 65535u));
-                    log(proc,
-                        (ins.op == OpCode::ADD ? "ADD(" : "SUB(")
-                      + ins.arg1 + ", " + ins.arg2 + ", " + ins.arg3 + ')',
-                        indent);
-                    break;
-                }
+    // The clock may still be retiring the last cycle's hand-backs; wait until
+    // it is gone, then leave the process for the destructor to retire.
+    {
+        std::unique_lock<std::mutex> lk(clockMutex);
+        clockCv.wait(lk, [&]{ return clockStopped; });
+    }
+    if (cur != kNoProcess) leave();
+}
 
-                case OpCode::SLEEP: {
-                    auto t = Stoi16(ins.arg2);
-                    proc.sleepTicks = (t>0 ? t-1 : 0);
-                    log(proc, "SLEEP " + std::to_string(t), indent);
-                    ++proc.executedLines;
-                    ++proc.currentLine;
-                    used = slice;
-                    if (used % config.quantumCycles == 0)
-                        writeMemorySnapshot();
-                    continue;
-                }
+// Clock thread, between cycles: the process core nCoreId handed back goes
+// where it belongs next. Finished ones free their memory, admit waiters, are
+// archived before their status flips, and give their PCB back.
+void Scheduler::retire(int nCoreId)
+{
+    CoreSlot& slot = slots[nCoreId - 1];
+    const ProcessHandle h = slot.proc;
+    ProcessInfo& proc     = (*registry)[h];
+    const bool finished   = proc.isFinished;
+    std::vector<ProcessHandle>& admitted = admittedScratch;
+    admitted.clear();
+
+    if (proc.reservedWork) {
+        const uint32_t done = finished ? proc.reservedWork
+            : std::min(proc.reservedWork, static_cast<uint32_t>(std::max(0, slot.ran)));
+        proc.reservedWork -= done;
+        deadlineWork      -= done;
+    }
+    --coresInUse;
+
+    ProcessStatus st = registry->status(h).read();
+    if (finished) {
+        memory.release(proc.processID);
+        admitMemoryWaiters(admitted);
+
+        st.state         = ProcState::FINISHED;
+        st.finishedCycle = cycle.load();
+        if (proc.deadline)
+            ++(st.finishedCycle <= proc.deadline ? deadlinesMet : deadlinesMissed);
+
+        FinishedSummary s;
+        s.pid           = proc.processID;
+        s.core          = static_cast<int16_t>(nCoreId);
+        s.total         = static_cast<uint32_t>(proc.totalLine);
+        s.migrations    = proc.migrations;
+        s.arrivalCycle  = proc.arrivalCycle;
+        s.finishedCycle = st.finishedCycle;
+        std::snprintf(s.name, sizeof(s.name), "%s", proc.processName.c_str());
+        Data::formatTimestamp(proc.createdMs, s.timeStamp, sizeof(s.timeStamp));
+        archive.add(s);
+    }
+    else {
+        st.state = proc.sleepTicks ? ProcState::SLEEPING : ProcState::READY;
+    }
+    registry->status(h).publish(st);
+
+    // Waiters admitted by this release are resident now; make them runnable.
+    for (ProcessHandle a : admitted) {
+        const ProcessInfo& p = (*registry)[a];
+        ready->push(p.assignedCore > 0 || p.affinity ? homeQueue(p)
+                                                     : static_cast<int>(nextQueue++ % numQueues), a);
+        ++readyCount;
+    }
 
-                case OpCode::FOR: {
-                    auto  body = ins.body;
-                    auto  reps = ins.repetitions;
-                    if (!body.empty() && reps > 0 && loopStack.size() < 3) {
-                        int bodySz   = static_cast<int>(body.size());
-                        int insertAt = proc.currentLine + 1;
-
-                        proc.prog.insert(
-                            proc.prog.begin() + insertAt,
-                            body.begin(), body.end()
-                        );
-
-                        for (auto& f : loopStack)
-                            if (f.end >= insertAt) f.end += bodySz;
-
-                        loopStack.push_back({
-                            uint16_t(insertAt),
-                            uint16_t(insertAt + bodySz - 1),
-                            uint16_t(reps - 1),
-                            indent
-                        });
-
-                        log(proc,
-                            "FOR×" + std::to_string(reps)
-                        + " body=" + std::to_string(bodySz),
-                            indent
-                        );
-                    }
-                    break;
-                }
+    // Preempted work goes back on this core's own queue; idle cores steal it.
+    if (proc.sleepTicks)
+        parkSleeping(h);
+    else if (!finished) {
+        ready->push(nCoreId - 1, h);
+        ++readyCount;
+    }
 
-                default: break;
-            }
+    // Frees the PCB with its program, registers and loop stack.
+    if (finished)
+        registry->erase(h);
+    slot = CoreSlot{};
+}
 
-            ++proc.currentLine;
-            ++proc.executedLines;
-            if (proc.executedLines > proc.totalLine)
-                proc.totalLine = proc.executedLines;
-            ++used;
-            if (used % config.quantumCycles == 0)
-                writeMemorySnapshot();
-
-            if (!loopStack.empty()) {
-                auto& top = loopStack.back();
-                if (proc.currentLine > top.end) {
-                    if (top.remain) {
-                        --top.remain;
-                        proc.currentLine = top.start;
-                    }
-                    else {
-                        loopStack.pop_back();
-                    }
-                }
+// Clock thread, between cycles: fills idle cores in core-ID order. A process
+// that cannot get memory parks on the memory-wait queue until a release
+// admits it; keep looking through the ready work.
+template <class Policy>
+void Scheduler::dispatch()
+{
+    using Queue = typename Policy::Queue;
+    Queue& queue = static_cast<Queue&>(*ready);
+
+    for (int core = 1; core <= config.numCpu; ++core) {
+        CoreSlot& slot = slots[core - 1];
+        if (slot.proc != kNoProcess) continue;
+
+        ProcessHandle h;
+        for (int tries = readyCount.load(); tries > 0; --tries) {
+            if (!queue.pop(core - 1, h)) break;
+            ProcessInfo& p = (*registry)[h];
+            --readyCount;
+
+            // Newcomers queue behind earlier waiters instead of jumping them.
+            if (!memory.isResident(p.processID)
+             && !(memWaiters.empty()
+                  && memory.allocate(p.processID, p.processName, config.memPerProc))) {
+                parkMemoryWait(h);
+                continue;
             }
+
+            if (p.assignedCore > 0 && p.assignedCore != core)
+                ++p.migrations;
+            p.assignedCore = core;
+            ++coresInUse;
+
+            ProcessStatus st = registry->status(h).read();
+            st.state      = ProcState::RUNNING;
+            st.core       = static_cast<int16_t>(core);
+            st.migrations = p.migrations;
+            registry->status(h).publish(st);
+
+            slot.proc  = h;
+            slot.slice = Policy::slice(config, p, readyCount.load() + coresInUse.load());
+            break;
+        }
+    }
+}
+
+bool Scheduler::awaitCycle(uint64_t& seen)
+{
+    // Cycles are short in turbo mode, so spin briefly before blocking.
+    for (int spin = 0; spin < 64; ++spin) {
+        if (!running) return false;
+        if (cycle.load(std::memory_order_acquire) != seen) {
+            seen = cycle.load(std::memory_order_acquire);
+            return true;
         }
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lk(clockMutex);
+    clockCv.wait(lk, [&]{ return cycle.load() != seen || !running; });
+    if (!running) return false;
+    seen = cycle.load();
+    return true;
+}
+
+void Scheduler::arriveCycle()
+{
+    if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == config.numCpu) {
+        std::lock_guard<std::mutex> lk(clockMutex);
+        doneCv.notify_one();
+    }
+}
+
+void Scheduler::setCycleHook(std::function<void(uint64_t)> hook)
+{
+    {
+        std::lock_guard<std::mutex> lk(hookMutex);
+        cycleHook = std::move(hook);
+        hookActive = static_cast<bool>(cycleHook);
+    }
+    {
+        std::lock_guard<std::mutex> lk(idleMutex);
+    }
+    cv.notify_all();
+}
+
+// Like the cores, the clock runs as clockLoop<Policy> for the policy picked once.
+void Scheduler::clockFunction()
+{
+    Rng::bindThread(Rng::kClockStream);     // batch generation runs in the cycle hook
+    withPolicy(kind, [&](auto tag) {
+        this->clockLoop<typename decltype(tag)::type>();
+    });
+}
 
-        if (config.delaysPerExec)
-            std::this_thread::sleep_for(
-              std::chrono::milliseconds(config.delaysPerExec)
-            );
+template <class Policy>
+void Scheduler::clockLoop()
+{
+    while (running)
+    {
+        // With nothing to run, time would only tick empty cycles and write
+        // empty snapshots; park until work or the batch hook shows up.
+        {
+            std::unique_lock<std::mutex> lk(idleMutex);
+            cv.wait(lk, [&]{ return !running || !idle() || hookActive.load(); });
+            if (!running) break;
+        }
 
-        bool finished = (proc.currentLine >= static_cast<int>(proc.prog.size()))
-                     && proc.sleepTicks == 0;
+        dispatch<Policy>();
+        tickDelay();
 
         {
-            std::lock_guard<std::mutex> lk(queueMutex);
-
-            runningProcesses.erase(
-                std::remove_if(
-                    runningProcesses.begin(),
-                    runningProcesses.end(),
-                    [&](auto const& p){ return p.processID == proc.processID; }
-                ),
-                runningProcesses.end()
-            );
-            --coresInUse;
-
-            if (!proc.outBuf.empty()) {
-                std::ofstream f(proc.processName + ".txt", std::ios::app);
-                for (auto& line : proc.outBuf) f << line << "\n";
-                proc.outBuf.clear();
-            }
+            std::lock_guard<std::mutex> lk(clockMutex);
+            arrived = 0;
+            cycle.fetch_add(1, std::memory_order_release);
+        }
+        clockCv.notify_all();
 
-            if (finished) {
-                deallocateMemory(proc.processName);
-                finishedProcesses.emplace_back(proc, nCoreId);
-            }
-            else {
-                processQueue.push_back(std::move(proc));
-            }
+        for (int spin = 0; spin < 64 && arrived.load() < config.numCpu; ++spin)
+            std::this_thread::yield();
+        {
+            std::unique_lock<std::mutex> lk(clockMutex);
+            doneCv.wait(lk, [&]{ return arrived.load() == config.numCpu || !running; });
+        }
+        if (!running) break;
+
+        // Every per-cycle side effect runs here, once, between cycles.
+        const uint64_t now = cycle.load();
+        busyCoreCycles += coresInUse.load();
+        for (int core = 1; core <= config.numCpu; ++core)
+            if (slots[core - 1].leaving) retire(core);
+        wakeSleepers(now);
+        ready->tick(now);
+        if (now % kPrefetchEvery == 0)
+            prefetchUpcoming();
+
+        // The batch hook keeps an idle clock ticking; nothing to snapshot then.
+        if (config.quantumCycles > 0 && now % config.quantumCycles == 0 && !idle())
+            writeMemorySnapshot();
+
+        if (hookActive) {
+            std::lock_guard<std::mutex> lk(hookMutex);
+            if (cycleHook) cycleHook(now);
         }
+    }
 
-        cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lk(clockMutex);
+        clockStopped = true;
     }
+    clockCv.notify_all();
 }
\ No newline at end of file
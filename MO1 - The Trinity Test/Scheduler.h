@@ -8,50 +8,141 @@
 #include <condition_variable>
 #include <atomic>
 #include <string>
+#include <memory>
+#include <functional>
+#include <map>
 #include "ProcessInfo.h"
 #include "Config.h"
+#include "TimerWheel.h"
+#include "LogPipeline.h"
+#include "MemoryAllocator.h"
+#include "ProcessRegistry.h"
+#include "FinishedArchive.h"
+#include "ProgramPool.h"
+#include "ReadyQueue.h"
+#include "SchedPolicy.h"
 
-struct MemoryBlock {
-    int start;
-    int end;
-    std::string pid;
-};
+// What became of a process handed to addProcess.
+enum class AddResult { ADDED, NAME_TAKEN, DEADLINE_REJECTED };
 
 class Scheduler {
 public:
-    explicit Scheduler(const Config& config);
+    Scheduler(const Config& config, std::shared_ptr<ProcessRegistry> registry);
     ~Scheduler();
     void start();
     void stop();
-    void addProcess(ProcessInfo&& proc);
-    void addProcess(const ProcessInfo& proc);
-    ProcessInfo& getProcess(const std::string& name);
-    ProcessInfo snapshotProcess(const std::string& name);
-    std::vector<std::pair<ProcessInfo,int>> getFinishedProcesses();
-    std::vector<ProcessInfo> getRunningProcesses();
-    std::vector<ProcessInfo> getWaitingProcesses();
+    AddResult addProcess(ProcessInfo&& proc);         // ADDED, or why it was turned away
+    std::size_t addProcesses(std::vector<ProcessInfo>&& batch);    // returns how many were new
+    bool processStatus(const std::string& name, ProcessStatus& out) const;    // false if unknown
+    std::vector<ProcessStatus> statusList() const;     // lock-free, live processes only
+    std::vector<FinishedSummary> finishedList() const { return archive.recent(); }
+    uint64_t finishedSpilled() { return archive.spilled(); }
+    const std::string& finishedSpillPath() const { return archive.spillPath(); }
+    bool knows(const std::string& name) const;         // live or finished, spilled too
+    void queryFinished(const ColumnQuery& q, std::ostream& os) { archive.query(q, os); }
     std::string utilisationString() const;
+    uint64_t ticks() const { return cycle.load(); }
+    bool idle() const {
+        return readyCount.load() == 0 && coresInUse.load() == 0
+            && sleepingCount.load() == 0;
+    }
+    void setCycleHook(std::function<void(uint64_t)> hook);
 
 private:
     Config config;
-    int quantum;
-    std::string schedulerType;
-    std::deque<ProcessInfo> processQueue;
-    std::vector<ProcessInfo> runningProcesses;
-    std::vector<std::pair<ProcessInfo,int>> finishedProcesses;
+    SchedKind kind;
+    int numQueues;
+    std::unique_ptr<ReadyQueue> ready;      // handles of PCBs owned by the registry
+    std::atomic<int> readyCount{0};
+    std::atomic<unsigned> nextQueue{0};
+    std::shared_ptr<ProcessRegistry> registry;
     std::vector<std::thread> coreThreads;
-    std::mutex queueMutex;
+    std::mutex idleMutex;       // parks the clock while nothing can run
     std::condition_variable cv;
     std::atomic<bool> running{true};
     std::atomic<int> coresInUse{0};
+
+    // Global CPU cycle: the clock thread advances it, every core runs one
+    // tick per cycle and arrives before the next one starts.
+    //
+    // Cores only run ticks. Between cycles the clock retires what each core
+    // handed back and dispatches ready work, both in core-ID order, so the
+    // same seed and the same commands make the same choices every run.
+    struct CoreSlot {
+        ProcessHandle proc{kNoProcess};     // set by the clock, cleared when retired
+        int  slice{0};                      // ticks this dispatch, from the policy
+        int  ran{0};                        // ticks actually run, set when leaving
+        bool leaving{false};                // core is done with it; clock retires it
+    };
+    std::vector<CoreSlot> slots;            // one per core, index core ID - 1
+    std::vector<ProcessHandle> admittedScratch;     // clock-thread scratch for retire
+    std::thread clockThread;
+    std::mutex clockMutex;
+    std::condition_variable clockCv;        // cores wait for a new cycle
+    std::condition_variable doneCv;         // clock waits for all arrivals
+    std::atomic<uint64_t> cycle{0};
+    std::atomic<int> arrived{0};
+    bool clockStopped{false};               // guarded by clockMutex; cores hand back after it
+    std::atomic<uint64_t> busyCoreCycles{0};
+    std::mutex hookMutex;
+    std::function<void(uint64_t)> cycleHook;
+    std::atomic<bool> hookActive{false};
+
+    // Process output; cores only enqueue records, a writer thread does the I/O.
+    LogPipeline logs;
+
+    // Processes parked by SLEEP, off-core until their wake-up cycle.
+    std::mutex sleepMutex;
+    TimerWheel<ProcessHandle> sleepers;
+    std::vector<ProcessHandle> woken;       // clock-thread scratch for wakeSleepers
+    std::atomic<int> sleepingCount{0};
     int curQuantumCycle{0};
-    std::vector<MemoryBlock> memoryBlocks;
+    MemoryAllocator memory;     // clock thread only
+
+    // Processes refused memory. They sit here, off the ready queues, until a
+    // release frees enough frames; keyed by (request size or 0, arrival) so
+    // the map order is the admission order. Clock thread only.
+    std::map<std::pair<int, uint64_t>, ProcessHandle> memWaiters;
+    uint64_t memWaitSeq{0};
+    bool smallestFitFirst;
+
+    // Deadlines: work admitted with one and not yet run, and how they ended.
+    std::atomic<int64_t>  deadlineWork{0};
+    std::atomic<uint64_t> deadlinesMet{0};
+    std::atomic<uint64_t> deadlinesMissed{0};
+    std::atomic<uint64_t> deadlinesRejected{0};
+
+    // Finished processes, compacted; their PCBs go back to the registry.
+    FinishedArchive archive;
+
+    // Builds seeded programs ahead of their first dispatch.
+    ProgramPool programs;
+    std::vector<ProcessHandle>  upcoming;   // clock-thread scratch for prefetchUpcoming
+    std::vector<ProgramRequest> wanted;
 
     void coreFunction(int coreId);
+    template <class Policy> void coreLoop(int coreId);
+    void clockFunction();
+    template <class Policy> void clockLoop();
+    template <class Policy> void dispatch();
+    void retire(int coreId);
+    bool awaitCycle(uint64_t& seen);
+    void arriveCycle();
+    void pushReady(int queueIdx, ProcessHandle proc);
+    void wakeClock();
+    void parkSleeping(ProcessHandle proc);
+    void wakeSleepers(uint64_t now);
     int getRandomInt(int floor, int ceiling);
-    bool allocateMemory(ProcessInfo& proc);
-    void deallocateMemory(const std::string& pid);
+    void parkMemoryWait(ProcessHandle proc);
+    void admitMemoryWaiters(std::vector<ProcessHandle>& admitted);
+    void setState(ProcessHandle h, ProcState state);
+    void materialize(ProcessInfo& proc);
+    void prefetchUpcoming();
+    ProcessHandle admit(ProcessInfo&& proc, AddResult& why);
+    int homeQueue(const ProcessInfo& p) const;
+    bool fitsDeadline(int64_t promised, uint32_t work, uint32_t ticks) const;
     void writeMemorySnapshot();
+    void tickDelay() const;
 };
 
 #endif
\ No newline at end of file
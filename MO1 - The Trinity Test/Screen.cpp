@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Screen.h"
+#include "Data.h"
 
 std::string banner = R"(
 *************************************************************************************
@@ -24,6 +25,7 @@ Available Commands:
     screen
     scheduler-start
     scheduler-stop
+    scheduler-burst
     report-util
     clear
     exit
@@ -51,7 +53,7 @@ void Screen::lsScreenView(const ProcessInfo& process) {
     std::cout << "Process Name: " << process.processName << std::endl;
     std::cout << "Current Line: " << process.currentLine << std::endl;
     std::cout << "Total Lines: " << process.totalLine << std::endl;
-    std::cout << "Timestamp: " << process.timeStamp << std::endl;
+    std::cout << "Timestamp: " << Data::formatTimestamp(process.createdMs) << std::endl;
 }
 
 void Screen::clearScreen() const {
@@ -0,0 +1,38 @@
+#include "ShortestFirstQueue.h"
+#include "ProcessRegistry.h"
+
+ShortestFirstQueue::ShortestFirstQueue(ProcessRegistry& registry)
+    : registry(registry) {}
+
+void ShortestFirstQueue::enqueue(ProcessHandle h)
+{
+    const ProcessInfo& p = registry[h];
+    const int64_t remaining = static_cast<int64_t>(p.totalLine) - p.executedLines;
+    heap.push(Entry{ remaining, nextSeq++, h });
+}
+
+void ShortestFirstQueue::push(int, ProcessHandle h)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    enqueue(h);
+}
+
+void ShortestFirstQueue::pushMany(const std::vector<std::vector<ProcessHandle>>& dealt)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    for (const auto& q : dealt)
+        for (ProcessHandle h : q) enqueue(h);
+}
+
+bool ShortestFirstQueue::pop(int queueIdx, ProcessHandle& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    return popHeapIf(heap, passed,
+                     [&](ProcessHandle h) { return registry[h].allowedOn(queueIdx + 1); }, out);
+}
+
+void ShortestFirstQueue::peek(std::size_t n, std::vector<ProcessHandle>& out)
+{
+    std::lock_guard<std::mutex> lk(mx);
+    peekHeap(heap, n, out);
+}
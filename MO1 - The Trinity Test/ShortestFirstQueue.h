@@ -0,0 +1,51 @@
+/* ---------- ShortestFirstQueue.h ---------- */
+#ifndef SHORTESTFIRSTQUEUE_H
+#define SHORTESTFIRSTQUEUE_H
+
+#include <queue>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include "ReadyQueue.h"
+
+class ProcessRegistry;
+
+/*
+ * Ready set of the sjf and srtf schedulers: a min-heap keyed on remaining
+ * instructions (totalLine - executedLines), shared by all cores, with ties
+ * going to the earlier arrival. The key is taken when the process is queued,
+ * when it cannot be running. Until its first dispatch a seeded process only
+ * knows its logical size, so that stands in for the executed count.
+ */
+class ShortestFirstQueue final : public ReadyQueue {
+public:
+    explicit ShortestFirstQueue(ProcessRegistry& registry);
+
+    void push(int queueIdx, ProcessHandle h) override;
+    bool pop(int queueIdx, ProcessHandle& out) override;
+    void pushMany(const std::vector<std::vector<ProcessHandle>>& dealt) override;
+    void peek(std::size_t n, std::vector<ProcessHandle>& out) override;
+
+private:
+    struct Entry {
+        int64_t       remaining;
+        uint64_t      seq;          // arrival order, breaks ties
+        ProcessHandle h;
+
+        bool operator>(const Entry& o) const {
+            return remaining != o.remaining ? remaining > o.remaining : seq > o.seq;
+        }
+    };
+
+    ProcessRegistry& registry;
+
+    std::mutex mx;
+    MinHeap<Entry> heap;
+    std::vector<Entry> passed;  // pop() scratch
+    uint64_t nextSeq{0};
+
+    void enqueue(ProcessHandle h);          // caller holds mx
+};
+
+#endif
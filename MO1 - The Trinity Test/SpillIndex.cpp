@@ -0,0 +1,110 @@
+#include "SpillIndex.h"
+#include <cstdio>
+
+namespace {
+    constexpr std::ios::openmode kMode =
+        std::ios::in | std::ios::out | std::ios::binary;
+}
+
+SpillIndex::SpillIndex(std::string path) : path(std::move(path))
+{
+    create(file, this->path, kInitialSlots);
+    slots = kInitialSlots;
+}
+
+// FNV-1a, 64-bit.
+uint64_t SpillIndex::hashName(const std::string& name)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : name) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Every run starts with an empty table, like the column files.
+void SpillIndex::create(std::fstream& f, const std::string& at, uint64_t n)
+{
+    f.close();
+    {
+        std::ofstream out(at, std::ios::binary | std::ios::trunc);
+        const std::vector<char> zeros(64 * sizeof(Slot), 0);
+        for (uint64_t done = 0; done < n; done += 64)
+            out.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+    f.open(at, kMode);
+}
+
+bool SpillIndex::readSlot(uint64_t i, Slot& s) const
+{
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(i * sizeof(Slot)));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&s), sizeof(Slot)));
+}
+
+void SpillIndex::writeSlot(std::fstream& f, uint64_t i, const Slot& s)
+{
+    f.clear();
+    f.seekp(static_cast<std::streamoff>(i * sizeof(Slot)));
+    f.write(reinterpret_cast<const char*>(&s), sizeof(Slot));
+}
+
+// Linear probe for the first empty slot of an n-slot table in f.
+void SpillIndex::insert(std::fstream& f, uint64_t n, const Slot& s)
+{
+    for (uint64_t i = s.hash & (n - 1);; i = (i + 1) & (n - 1)) {
+        Slot cur{};
+        f.clear();
+        f.seekg(static_cast<std::streamoff>(i * sizeof(Slot)));
+        if (!f.read(reinterpret_cast<char*>(&cur), sizeof(Slot)) || cur.seqPlusOne == 0) {
+            writeSlot(f, i, s);
+            return;
+        }
+    }
+}
+
+void SpillIndex::add(const std::string& name, const SpillEntry& e)
+{
+    if ((used + 1) * 2 > slots) grow();
+    insert(file, slots, Slot{ hashName(name), e.seq + 1, e.offset });
+    ++used;
+}
+
+void SpillIndex::candidates(const std::string& name, std::vector<SpillEntry>& out) const
+{
+    out.clear();
+    if (!file.is_open()) return;
+    const uint64_t h = hashName(name);
+    Slot s{};
+    for (uint64_t i = h & (slots - 1); readSlot(i, s) && s.seqPlusOne; i = (i + 1) & (slots - 1))
+        if (s.hash == h) out.push_back(SpillEntry{ s.seqPlusOne - 1, s.offset });
+}
+
+// Rebuilds the table at twice the size beside the old one, then swaps it in.
+// Amortised over the insertions since the last rebuild, this is O(1) each.
+void SpillIndex::grow()
+{
+    const uint64_t n = slots * 2;
+    const std::string tmp = path + ".tmp";
+    std::fstream bigger;
+    create(bigger, tmp, n);
+
+    // The old table is read front to back, a block at a time.
+    std::vector<Slot> block(1024);
+    file.clear();
+    file.seekg(0);
+    for (uint64_t i = 0; i < slots; i += block.size()) {
+        if (!file.read(reinterpret_cast<char*>(block.data()),
+                       static_cast<std::streamsize>(block.size() * sizeof(Slot)))) break;
+        for (const Slot& s : block)
+            if (s.seqPlusOne) insert(bigger, n, s);
+    }
+
+    bigger.close();
+    file.close();
+    std::remove(path.c_str());
+    std::rename(tmp.c_str(), path.c_str());
+    file.open(path, kMode);
+    slots = n;
+}
@@ -0,0 +1,59 @@
+/* ---------- SpillIndex.h ---------- */
+#ifndef SPILLINDEX_H
+#define SPILLINDEX_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Where one spilled summary sits: its archive sequence number and the byte
+// offset of its line in the spill file.
+struct SpillEntry {
+    uint64_t seq;
+    uint64_t offset;
+};
+
+/*
+ * On-disk name index over the spill file.
+ * An open-addressing hash table of fixed 24-byte slots (name hash, seq + 1,
+ * spill offset) kept in its own file, so memory stays flat however many
+ * processes spill. Slots are probed linearly; the table doubles and is
+ * rebuilt once it is half full. Matches are by hash only, so callers check
+ * the name against the spill line. Not thread-safe: FinishedArchive calls
+ * it under its io lock.
+ */
+class SpillIndex {
+public:
+    explicit SpillIndex(std::string path);
+
+    SpillIndex(const SpillIndex&) = delete;
+    SpillIndex& operator=(const SpillIndex&) = delete;
+
+    void add(const std::string& name, const SpillEntry& e);
+    // Every entry whose name hashes like `name`, oldest first.
+    void candidates(const std::string& name, std::vector<SpillEntry>& out) const;
+
+private:
+    static constexpr uint64_t kInitialSlots = 4096;
+
+    struct Slot {
+        uint64_t hash;
+        uint64_t seqPlusOne;    // 0: empty
+        uint64_t offset;
+    };
+
+    std::string path;
+    mutable std::fstream file;
+    uint64_t slots{0};          // a power of two
+    uint64_t used{0};
+
+    static uint64_t hashName(const std::string& name);
+    void create(std::fstream& f, const std::string& at, uint64_t n);
+    bool readSlot(uint64_t i, Slot& s) const;
+    void writeSlot(std::fstream& f, uint64_t i, const Slot& s);
+    void insert(std::fstream& f, uint64_t n, const Slot& s);
+    void grow();
+};
+
+#endif
@@ -0,0 +1,106 @@
+/* ---------- TimerWheel.h ---------- */
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+/*
+ * Hierarchical timing wheel keyed by CPU cycle.
+ * Four levels of 64 slots cover 64^4 cycles; longer delays are clamped.
+ * schedule() is O(1); advance() is O(1) per cycle plus the expired entries
+ * (and the occasional cascade of one higher-level slot).
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+    explicit TimerWheel(uint64_t now = 0) : current(now) {}
+
+    void schedule(uint64_t due, T&& item)
+    {
+        if (due <= current) due = current + 1;
+        if (due - current >= kSpan) due = current + kSpan - 1;
+        place(Entry{ due, std::move(item) });
+        ++count;
+    }
+
+    // Moves the wheel up to `now`, handing every expired item to onExpire.
+    template <typename F>
+    void advance(uint64_t now, F&& onExpire)
+    {
+        while (current < now) {
+            ++current;
+
+            for (int lvl = 1; lvl < kLevels; ++lvl) {
+                if (current & ((uint64_t(1) << (kBits * lvl)) - 1)) break;
+                std::vector<Entry> moved;
+                moved.swap(slots[lvl][index(current, lvl)]);
+                for (auto& e : moved) place(std::move(e));
+            }
+
+            std::vector<Entry> due;
+            due.swap(slots[0][index(current, 0)]);
+            for (auto& e : due) {
+                --count;
+                onExpire(std::move(e.item));
+            }
+        }
+    }
+
+    // An empty wheel has nothing to expire on the way, so it can jump straight
+    // to `now` instead of walking every cycle it sat idle.
+    void reset(uint64_t now)
+    {
+        if (count == 0 && now > current) current = now;
+    }
+
+    template <typename F>
+    void forEach(F&& fn) const
+    {
+        for (const auto& level : slots)
+            for (const auto& slot : level)
+                for (const auto& e : slot) fn(e.item);
+    }
+
+    template <typename F>
+    void forEach(F&& fn)
+    {
+        for (auto& level : slots)
+            for (auto& slot : level)
+                for (auto& e : slot) fn(e.item);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    static constexpr int      kBits   = 6;
+    static constexpr int      kSlots  = 1 << kBits;
+    static constexpr int      kLevels = 4;
+    static constexpr uint64_t kSpan   = uint64_t(1) << (kBits * kLevels);
+
+    struct Entry { uint64_t due; T item; };
+
+    std::vector<Entry> slots[kLevels][kSlots];
+    uint64_t    current;
+    std::size_t count{0};
+
+    static std::size_t index(uint64_t t, int lvl)
+    {
+        return static_cast<std::size_t>((t >> (kBits * lvl)) & (kSlots - 1));
+    }
+
+    void place(Entry&& e)
+    {
+        const uint64_t delta = e.due - current;
+        int lvl = 0;
+        while (lvl + 1 < kLevels && delta >= (uint64_t(1) << (kBits * (lvl + 1))))
+            ++lvl;
+        slots[lvl][index(e.due, lvl)].push_back(std::move(e));
+    }
+};
+
+#endif
@@ -8,25 +8,25 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 class ProcessList {
     std::vector<ProcessInfo> ProcList;
+    std::unordered_map<std::string, std::size_t> ByName;   // name -> index in ProcList
 
     void addProcess(const ProcessInfo& new_process) {
-        for (auto& process : ProcList) {
-            if (process.processName == new_process.processName) {
-                std::cout << "Process: " << process.processName << "already exists." << std::endl;
-                return;
-            }
+        if (ByName.count(new_process.processName)) {
+            std::cout << "Process: " << new_process.processName << "already exists." << std::endl;
+            return;
         }
+        ByName.emplace(new_process.processName, ProcList.size());
         ProcList.push_back(new_process);
     }
 
     ProcessInfo* getProcess(const std::string& processName) {
-        for (auto& process : ProcList) {
-            if (process.processName == processName) {
-                return &process;
-            }
+        auto it = ByName.find(processName);
+        if (it != ByName.end()) {
+            return &ProcList[it->second];
         }
         return nullptr;
     }